@@ -0,0 +1,629 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/**
+ * This file contains the benchmarks.
+ * The storage benchmark replays the database workloads of the firmware against
+ * a simulated flash chip, so storage engines can be compared without wearing
+ * the real flash. The queue benchmark posts work to the main loop from several
+ * tasks at once. The container benchmark compares ArrayList with std::vector.
+ * The network benchmark sends bursts of publishes to a simulated connection,
+ * with and without corking, and reports the segments and the latency of a burst.
+ * The display benchmark renders every screen and scrolls the ongoing lines,
+ * reporting the time and the bus bytes of each frame.
+ *
+ * DO NOT put any other functions in this file.
+ */
+
+#include <algorithm>
+#include <atomic>
+
+#include "Function.h"
+#include "src/vendor/Simulator/FlashSimulator.h"
+#include "src/vendor/Simulator/TCPSimulator.h"
+
+namespace Benchmark {
+
+/**
+ * @brief A database configuration to benchmark.
+ *
+ */
+struct Configuration {
+    const char* name;
+    TinyDB::Engine engine;
+    uint32_t writeBehindDelay;
+};
+
+/**
+ * @brief The measurements of one workload.
+ * A latency is the CPU time of the operation plus the simulated flash time it spent.
+ *
+ */
+struct Result {
+    std::vector<uint32_t> latencies;
+    uint32_t logicalBytes = 0;
+    FlashSimulator::Statistics statistics;
+};
+
+const Configuration CONFIGURATIONS[] = {
+    {"Files", TinyDB::Files, 0},
+    {"Log", TinyDB::Log, 0},
+    {"Log+WriteBehind", TinyDB::Log, DB_WRITE_BEHIND_DELAY},
+};
+
+const uint8_t BOOT_COUNT        = 20;
+const uint16_t EDIT_COUNT       = 200;
+const uint16_t EDIT_INTERVAL    = 20;
+const uint8_t WEEK_COUNT        = 10;
+const uint16_t REWRITE_INTERVAL = 100;
+const uint16_t SETTLE_DURATION  = 3000;
+const uint8_t PRODUCER_COUNT    = 3;
+const uint16_t POST_COUNT       = 2000;
+const uint16_t ELEMENT_COUNT    = 500;
+const uint8_t CONTAINER_ROUNDS  = 20;
+const uint16_t SCROLL_FRAMES    = 200;
+const uint16_t SCROLL_INTERVAL  = 50;
+const uint8_t BURST_COUNT       = 50;
+const uint8_t BURST_SIZE        = 10;
+
+/**
+ * @brief Keep the main loop running for a while, so flushes and compactions happen like on the device.
+ *
+ * @param duration is the duration in milliseconds.
+ */
+void idle(const uint32_t& duration) {
+    uint32_t start = millis();
+    while (millis() - start < duration) {
+        Timer::run();
+        delay(1);
+    }
+}
+
+/**
+ * @brief Run an operation and record its latency.
+ *
+ * @param flash is the simulated flash.
+ * @param result is where the latency is recorded.
+ * @param operation is the operation.
+ */
+void measure(FlashSimulator& flash, Result& result, std::function<void()> operation) {
+    uint64_t busy  = flash.getStatistics().busyMicros;
+    uint32_t start = micros();
+    operation();
+    result.latencies.push_back(micros() - start + (flash.getStatistics().busyMicros - busy));
+}
+
+QiroGroup createSchedule(const DayOfWeek& day, const uint8_t& volume) {
+    std::vector<Surah> surahList;
+    for (uint16_t i = 0; i < 10; i++) {
+        surahList.push_back(Surah(i, volume));
+    }
+
+    return QiroGroup(
+        day, Qiro(Prayer::Fajr, 15, surahList), Qiro(Prayer::Dhuhr, 10, surahList), Qiro(Prayer::Asr, 10, surahList),
+        Qiro(Prayer::Maghrib, 10, surahList), Qiro(Prayer::Isha, 15, surahList)
+    );
+}
+
+/**
+ * @brief Write every key the firmware stores, like a device that has been set up.
+ *
+ * @param db is the database.
+ */
+void seed(TinyDB& db) {
+    const String SCHEDULE_KEYS[] = {KEY_SCHEDULE_MONDAY,   KEY_SCHEDULE_TUESDAY, KEY_SCHEDULE_WEDNESDAY,
+                                    KEY_SCHEDULE_THURSDAY, KEY_SCHEDULE_FRIDAY,  KEY_SCHEDULE_SATURDAY,
+                                    KEY_SCHEDULE_SUNDAY};
+
+    db.put(KEY_DEVICE, g_Device);
+    db.put(KEY_PRAYER_OFFSET, g_PrayerOffset);
+    db.put(KEY_SETTING_LOCATION, g_Location);
+    db.put(KEY_SETTING_WIFI, g_WiFi);
+    db.put(KEY_SETTING_SECURITY, g_Security);
+    for (uint8_t day = 0; day < 7; day++) {
+        db.put(SCHEDULE_KEYS[day], createSchedule((DayOfWeek)(day + 1), 20));
+    }
+    db.flush();
+}
+
+/**
+ * @brief Open the database and load every key, like initializeDatabase() does.
+ *
+ */
+Result runBootLoad(FlashSimulator& flash, const Configuration& configuration) {
+    Result result;
+    {
+        TinyDB db;
+        db.begin(flash, configuration.engine);
+        seed(db);
+    }
+
+    flash.resetStatistics();
+    for (uint8_t boot = 0; boot < BOOT_COUNT; boot++) {
+        TinyDB db;
+        measure(flash, result, [&]() {
+            db.begin(flash, configuration.engine);
+            Array keys = db.listFiles();
+            for (size_t i = 0; i < keys.size(); i++) {
+                String key = keys[i];
+                if (db.contains(key)) {
+                    db.get(key);
+                }
+            }
+        });
+    }
+
+    result.statistics = flash.getStatistics();
+    return result;
+}
+
+/**
+ * @brief Change a setting many times in a row, like dragging a slider in the app.
+ *
+ */
+Result runSettingEdits(FlashSimulator& flash, const Configuration& configuration) {
+    Result result;
+    TinyDB db;
+    db.begin(flash, configuration.engine);
+    db.setWriteBehind(configuration.writeBehindDelay);
+    seed(db);
+
+    flash.resetStatistics();
+    SettingGroup location = g_Location;
+    for (uint16_t i = 0; i < EDIT_COUNT; i++) {
+        location.getSetting(Config::LATITUDE).value = -6.0 - i * 0.001;
+        result.logicalBytes += KEY_SETTING_LOCATION.length() + location.serialize().length();
+        measure(flash, result, [&]() { db.put(KEY_SETTING_LOCATION, location); });
+        idle(EDIT_INTERVAL);
+    }
+
+    idle(SETTLE_DURATION);
+    db.flush();
+    result.statistics = flash.getStatistics();
+    return result;
+}
+
+/**
+ * @brief Rewrite the schedule of every day of the week, week after week.
+ *
+ */
+Result runScheduleRewrites(FlashSimulator& flash, const Configuration& configuration) {
+    const String SCHEDULE_KEYS[] = {KEY_SCHEDULE_MONDAY,   KEY_SCHEDULE_TUESDAY, KEY_SCHEDULE_WEDNESDAY,
+                                    KEY_SCHEDULE_THURSDAY, KEY_SCHEDULE_FRIDAY,  KEY_SCHEDULE_SATURDAY,
+                                    KEY_SCHEDULE_SUNDAY};
+
+    Result result;
+    TinyDB db;
+    db.begin(flash, configuration.engine);
+    db.setWriteBehind(configuration.writeBehindDelay);
+    seed(db);
+
+    flash.resetStatistics();
+    for (uint8_t week = 0; week < WEEK_COUNT; week++) {
+        for (uint8_t day = 0; day < 7; day++) {
+            QiroGroup schedule = createSchedule((DayOfWeek)(day + 1), week);
+            result.logicalBytes += SCHEDULE_KEYS[day].length() + schedule.serialize().length();
+            measure(flash, result, [&]() { db.put(SCHEDULE_KEYS[day], schedule); });
+            idle(REWRITE_INTERVAL);
+        }
+    }
+
+    idle(SETTLE_DURATION);
+    db.flush();
+    result.statistics = flash.getStatistics();
+    return result;
+}
+
+/**
+ * @brief Get a percentile of the sorted latencies.
+ *
+ * @param latencies is the sorted latencies.
+ * @param percentile is the percentile, from 0 to 100.
+ * @return the latency in microseconds.
+ */
+uint32_t percentile(const std::vector<uint32_t>& latencies, const uint8_t& percentile) {
+    if (latencies.empty()) {
+        return 0;
+    }
+    return latencies[(latencies.size() - 1) * percentile / 100];
+}
+
+void report(const char* workload, const Configuration& configuration, Result result, FlashSimulator& flash) {
+    std::sort(result.latencies.begin(), result.latencies.end());
+    uint32_t amplification =
+        result.logicalBytes > 0 ? (uint64_t)result.statistics.bytesProgrammed * 100 / result.logicalBytes : 0;
+
+    Log::info(
+        TAG_BENCHMARK, F("%s / %s: n=%u p50=%uus p90=%uus p99=%uus max=%uus"), workload, configuration.name,
+        (uint32_t)result.latencies.size(), percentile(result.latencies, 50), percentile(result.latencies, 90),
+        percentile(result.latencies, 99), result.latencies.empty() ? 0 : result.latencies.back()
+    );
+    Log::info(
+        TAG_BENCHMARK, F("%s / %s: programmed=%uB erased=%u write amplification=%u.%02u max erase count=%u"), workload,
+        configuration.name, result.statistics.bytesProgrammed, result.statistics.blocksErased, amplification / 100,
+        amplification % 100, flash.getMaxEraseCount()
+    );
+}
+
+/**
+ * @brief A task that posts work to the queue under test.
+ *
+ */
+struct Producer {
+    std::function<bool()> post;
+    std::vector<uint32_t> latencies;
+    std::atomic<bool> isDone{false};
+};
+
+void producerTask(void* parameter) {
+    Producer* producer = (Producer*)parameter;
+    for (uint16_t i = 0; i < POST_COUNT; i++) {
+        uint32_t start = micros();
+        while (!producer->post()) {
+            taskYIELD();
+        }
+        producer->latencies.push_back(micros() - start);
+    }
+    producer->isDone = true;
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Post from several tasks at once while the main loop drains the queue every tick.
+ * A latency includes the retries when the queue is full.
+ *
+ * @param post is how a producer posts an item. It returns false if the queue is full.
+ * @param drain is how the main loop runs the items.
+ */
+Result runPostContention(std::function<bool()> post, std::function<void()> drain) {
+    Producer producers[PRODUCER_COUNT];
+    for (uint8_t i = 0; i < PRODUCER_COUNT; i++) {
+        producers[i].post = post;
+        producers[i].latencies.reserve(POST_COUNT);
+        xTaskCreate(producerTask, "producer", 4096, &producers[i], 1, NULL);
+    }
+
+    bool isDone = false;
+    while (!isDone) {
+        drain();
+        vTaskDelay(1);
+
+        isDone = true;
+        for (const Producer& producer : producers) {
+            isDone = isDone && producer.isDone;
+        }
+    }
+    drain();
+
+    Result result;
+    for (const Producer& producer : producers) {
+        result.latencies.insert(result.latencies.end(), producer.latencies.begin(), producer.latencies.end());
+    }
+    return result;
+}
+
+void reportPostContention(const char* name, Result result) {
+    std::sort(result.latencies.begin(), result.latencies.end());
+    Log::info(
+        TAG_BENCHMARK, F("Post contention / %s: n=%u p50=%uus p90=%uus p99=%uus max=%uus"), name,
+        (uint32_t)result.latencies.size(), percentile(result.latencies, 50), percentile(result.latencies, 90),
+        percentile(result.latencies, 99), result.latencies.empty() ? 0 : result.latencies.back()
+    );
+}
+
+void runQueues() {
+    volatile uint32_t count = 0;
+
+    std::vector<std::function<void()>> vector;
+    SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+    Result result           = runPostContention(
+        [&]() {
+            xSemaphoreTake(mutex, portMAX_DELAY);
+            vector.push_back([&]() { count++; });
+            xSemaphoreGive(mutex);
+            return true;
+        },
+        [&]() {
+            xSemaphoreTake(mutex, portMAX_DELAY);
+            std::vector<std::function<void()>> items = vector;
+            vector.clear();
+            xSemaphoreGive(mutex);
+            for (auto& item : items) {
+                item();
+            }
+        }
+    );
+    vSemaphoreDelete(mutex);
+    reportPostContention("Mutex+vector", result);
+
+    WorkQueue<MAIN_QUEUE_CAPACITY> queue;
+    result = runPostContention([&]() { return queue.push([&]() { count++; }); }, [&]() { queue.run(); });
+    reportPostContention("WorkQueue", result);
+    Log::info(TAG_BENCHMARK, F("Post contention / WorkQueue: overflows=%u"), queue.getOverflowCount());
+}
+
+/**
+ * @brief An element like the ones the libraries keep in their lists: a handler with an id.
+ *
+ */
+struct Entry {
+    uint32_t id;
+    std::function<void()> handler;
+
+    bool operator==(const Entry& other) const {
+        return id == other.id;
+    }
+};
+
+/**
+ * @brief The time spent in each operation of a container, summed over the rounds.
+ *
+ */
+struct ContainerResult {
+    uint32_t addMicros     = 0;
+    uint32_t iterateMicros = 0;
+    uint32_t removeMicros  = 0;
+};
+
+/**
+ * @brief Fill a container, iterate over it and remove half of it, round after round.
+ *
+ * @param add adds an entry.
+ * @param iterate calls every handler.
+ * @param remove removes the entries with an odd id.
+ */
+template <typename Container, typename Add, typename Iterate, typename Remove>
+ContainerResult runContainer(Add add, Iterate iterate, Remove remove) {
+    volatile uint32_t count = 0;
+    ContainerResult result;
+    for (uint8_t round = 0; round < CONTAINER_ROUNDS; round++) {
+        Container container;
+
+        uint32_t start = micros();
+        for (uint16_t i = 0; i < ELEMENT_COUNT; i++) {
+            add(container, Entry{i, [&count]() { count++; }});
+        }
+        result.addMicros += micros() - start;
+
+        start = micros();
+        iterate(container);
+        result.iterateMicros += micros() - start;
+
+        start = micros();
+        remove(container);
+        result.removeMicros += micros() - start;
+    }
+    return result;
+}
+
+void reportContainer(const char* name, const ContainerResult& result) {
+    Log::info(
+        TAG_BENCHMARK, F("Container / %s: n=%u add=%uus iterate=%uus removeIf=%uus"), name, ELEMENT_COUNT,
+        result.addMicros / CONTAINER_ROUNDS, result.iterateMicros / CONTAINER_ROUNDS,
+        result.removeMicros / CONTAINER_ROUNDS
+    );
+}
+
+void runContainers() {
+    reportContainer(
+        "ArrayList", runContainer<ArrayList<Entry>>(
+                         [](ArrayList<Entry>& list, Entry&& entry) { list.add(std::move(entry)); },
+                         [](ArrayList<Entry>& list) {
+                             for (Entry& entry : list) {
+                                 entry.handler();
+                             }
+                         },
+                         [](ArrayList<Entry>& list) { list.removeIf([](const Entry& entry) { return entry.id % 2; }); }
+                     )
+    );
+
+    reportContainer(
+        "std::vector", runContainer<std::vector<Entry>>(
+                           [](std::vector<Entry>& vector, Entry&& entry) { vector.push_back(std::move(entry)); },
+                           [](std::vector<Entry>& vector) {
+                               for (Entry& entry : vector) {
+                                   entry.handler();
+                               }
+                           },
+                           [](std::vector<Entry>& vector) {
+                               vector.erase(
+                                   std::remove_if(
+                                       vector.begin(), vector.end(), [](const Entry& entry) { return entry.id % 2; }
+                                   ),
+                                   vector.end()
+                               );
+                           }
+                       )
+    );
+}
+
+/**
+ * @brief Send bursts of publishes to a simulated connection, like the ones sent when a prayer starts.
+ * The publishes of a burst are ready at once, so a latency is the time from the start
+ * of the burst until the last byte of the frame left.
+ *
+ * @param isCorked is true to cork the client during each burst, like WSServer::run() does.
+ * @param statistics is where the statistics of the connection are stored.
+ */
+Result runBursts(const bool& isCorked, TCPSimulator::Statistics& statistics) {
+    String message =
+        RTTP::Message(RTTP::SERVER_ID, "client", RTTP_TOPIC_PRAYER_ONGOING, RTTP::Message::Set, g_PrayerOngoing)
+            .serialize();
+    uint32_t frameLength = message.length() + (message.length() > 125 ? 4 : 2);
+
+    std::shared_ptr<TCPSimulator> connection = std::make_shared<TCPSimulator>();
+    WSClient client(connection);
+    client.setUseMask(false);
+
+    Result result;
+    for (uint8_t burst = 0; burst < BURST_COUNT; burst++) {
+        connection->resetStatistics();
+        uint64_t start = connection->now();
+        if (isCorked) {
+            client.cork();
+        }
+        for (uint8_t i = 0; i < BURST_SIZE; i++) {
+            client.sendText(message);
+        }
+        if (isCorked) {
+            client.uncork();
+        }
+
+        for (uint8_t i = 0; i < BURST_SIZE; i++) {
+            uint64_t leftAt = connection->getDepartureTime((i + 1) * frameLength - 1);
+            result.latencies.push_back(leftAt - start);
+        }
+
+        TCPSimulator::Statistics burstStatistics = connection->getStatistics();
+        statistics.transmits += burstStatistics.transmits;
+        statistics.segments += burstStatistics.segments;
+        statistics.bytes += burstStatistics.bytes;
+        statistics.busyMicros += burstStatistics.busyMicros;
+    }
+    return result;
+}
+
+void reportBursts(const char* name, Result result, const TCPSimulator::Statistics& statistics) {
+    std::sort(result.latencies.begin(), result.latencies.end());
+    Log::info(
+        TAG_BENCHMARK, F("Network / %s: bursts=%u size=%u segments=%u.%02u/burst bytes=%u/burst"), name, BURST_COUNT,
+        BURST_SIZE, statistics.segments / BURST_COUNT, statistics.segments * 100 / BURST_COUNT % 100,
+        statistics.bytes / BURST_COUNT
+    );
+    Log::info(
+        TAG_BENCHMARK, F("Network / %s: n=%u p50=%uus p90=%uus p99=%uus max=%uus"), name,
+        (uint32_t)result.latencies.size(), percentile(result.latencies, 50), percentile(result.latencies, 90),
+        percentile(result.latencies, 99), result.latencies.empty() ? 0 : result.latencies.back()
+    );
+}
+
+void runNetwork() {
+    TCPSimulator::Statistics uncorked;
+    reportBursts("Uncorked", runBursts(false, uncorked), uncorked);
+
+    TCPSimulator::Statistics corked;
+    reportBursts("Corked", runBursts(true, corked), corked);
+}
+
+/**
+ * @brief Hash the pixels of the display, so the frames of two builds can be compared
+ * without dumping them.
+ *
+ * @return the FNV-1a hash of the pixels.
+ */
+uint32_t hashFrame() {
+    uint32_t hash = 2166136261UL;
+    for (int16_t y = 0; y < g_OLED.height(); y++) {
+        for (int16_t x = 0; x < g_OLED.width(); x++) {
+            hash = (hash ^ g_OLED.getPixel(x, y)) * 16777619UL;
+        }
+    }
+    return hash;
+}
+
+/**
+ * @brief Render a screen and report how long it took until it was on the display.
+ * The frame is also printed as a PBM image in debug mode.
+ *
+ * @param name is the name of the screen.
+ * @param show renders the screen.
+ */
+void reportScreen(const char* name, std::function<void()> show) {
+    uint32_t busBytes = g_OLED.getBusBytes();
+    uint32_t start    = micros();
+    show();
+    uint32_t renderMicros = micros() - start;
+    g_OLED.waitForTransfer();
+    uint32_t frameMicros = micros() - start;
+
+    Log::info(
+        TAG_BENCHMARK, F("Display / %s: render=%uus frame=%uus bus=%uB hash=%08x"), name, renderMicros, frameMicros,
+        g_OLED.getBusBytes() - busBytes, hashFrame()
+    );
+#if DEBUG
+    g_OLED.printPBM(Serial);
+#endif
+}
+
+/**
+ * @brief Scroll both ongoing lines like the scroll timer does, once the strips are rendered.
+ *
+ */
+void runScrolling() {
+    Display::renderStrip(F("Al-Fatihah, Al-Baqarah, Ali 'Imran, An-Nisa', Al-Ma'idah"), Display::surahStrip);
+    Display::renderStrip(F("Phone, Tablet, Laptop, Speaker"), Display::deviceStrip);
+    Display::xSurah            = g_OLED.width();
+    Display::xDevice           = g_OLED.width();
+    Display::isSurahScrolling  = true;
+    Display::isDeviceScrolling = true;
+
+    uint32_t busBytes       = g_OLED.getBusBytes();
+    uint32_t callerMicros   = 0;
+    uint32_t transferMicros = 0;
+    for (uint16_t i = 0; i < SCROLL_FRAMES; i++) {
+        uint32_t start = micros();
+        Display::scrollDisplay();
+        uint32_t sent = micros();
+        g_OLED.waitForTransfer();
+        callerMicros += sent - start;
+        transferMicros += micros() - sent;
+    }
+
+    uint32_t frameBytes = (g_OLED.getBusBytes() - busBytes) / SCROLL_FRAMES;
+    Log::info(
+        TAG_BENCHMARK, F("Display / Scrolling: frames=%u caller=%uus transfer=%uus bus=%uB/frame %uB/s"),
+        SCROLL_FRAMES, callerMicros / SCROLL_FRAMES, transferMicros / SCROLL_FRAMES, frameBytes,
+        frameBytes * 1000 / SCROLL_INTERVAL
+    );
+
+    Display::isSurahScrolling  = false;
+    Display::isDeviceScrolling = false;
+    std::vector<uint8_t>().swap(Display::surahStrip);
+    std::vector<uint8_t>().swap(Display::deviceStrip);
+}
+
+void runDisplay() {
+    reportScreen("Boot", Display::showBootMessage);
+
+    Display::isOnHold          = false;
+    Display::isShowingDateTime = false;
+    reportScreen("Ongoing", []() {
+        g_OLED.clearDisplay();
+        Display::showPrayerOngoing();
+        Display::showSurahOngoing();
+        Display::showConnectedDevice();
+    });
+    runScrolling();
+
+    reportScreen("Date and time", Display::showDateTime);
+    Display::isOnHold = true;
+}
+
+/**
+ * @brief Replay every storage workload against every database configuration, each on a fresh flash.
+ *
+ */
+void runStorage() {
+    for (const Configuration& configuration : CONFIGURATIONS) {
+        FlashSimulator boot;
+        report("Boot load", configuration, runBootLoad(boot, configuration), boot);
+
+        FlashSimulator edits;
+        report("Setting edits", configuration, runSettingEdits(edits, configuration), edits);
+
+        FlashSimulator rewrites;
+        report("Schedule rewrites", configuration, runScheduleRewrites(rewrites, configuration), rewrites);
+    }
+}
+
+void run() {
+    runDisplay();
+    runNetwork();
+    runContainers();
+    runQueues();
+    runStorage();
+}
+
+};  // namespace Benchmark
+
+#endif
@@ -4,6 +4,7 @@
 #define VERSION "1.0.0"
 #define DEBUG true
 #define SIMULATION false
+#define BENCHMARK false
 
 /**
  * This file contains all the definitions used in the project.
@@ -31,12 +32,15 @@
 #include "src/vendor/Adafruit/SSD1306/Adafruit_SSD1306.h"
 #include "src/vendor/Button/Button.h"
 #include "src/vendor/DFPlayer/DFRobotDFPlayerMini.h"
+#include "src/vendor/Executor/Executor.h"
 #include "src/vendor/Log/Log.h"
 #include "src/vendor/Output/Output.h"
 #include "src/vendor/RTTP/RTTP.h"
+#include "src/vendor/Sequence/Sequence.h"
 #include "src/vendor/Time/Time.h"
 #include "src/vendor/Timer/Timer.h"
 #include "src/vendor/TinyDB/TinyDB.h"
+#include "src/vendor/WorkQueue/WorkQueue.h"
 
 /*----- Relay Pins ------*/
 const uint8_t PIN_RELAY = 25;
@@ -67,6 +71,22 @@ const String KEY_SETTING_LOCATION   = F("s_location");
 const String KEY_SETTING_WIFI       = F("s_wifi");
 const String KEY_SETTING_SECURITY   = F("s_security");
 
+/*----- DB Write Behind ------*/
+const uint32_t DB_WRITE_BEHIND_DELAY = 1000;
+
+/*----- Executor ------*/
+const uint32_t EXECUTOR_STACK_SIZE = 16384;
+
+/*----- Surah List ------*/
+const uint16_t SURAH_LIST_BATCH_SIZE  = 10;
+const uint32_t SURAH_LIST_BATCH_DELAY = 100;
+
+/*----- Main Queue ------*/
+const size_t MAIN_QUEUE_CAPACITY         = 32;
+const uint8_t POST_SHOW_PRAYER_ONGOING   = 0;
+const uint8_t POST_SHOW_SURAH_ONGOING    = 1;
+const uint8_t POST_SHOW_CONNECTED_DEVICE = 2;
+
 /*----- Device Credential ------*/
 const String DEVICE_NAME  = F("Kiro");
 const String DEVICE_PASS  = F("12345678");
@@ -80,6 +100,7 @@ uint8_t MAC_ADDRESS[6] = {0x52, 0x4F, 0x58, 0x00, 0x00, 0x00};
 const uint16_t UDP_PORT = 46525;
 
 /*----- RTTP -----*/
+const uint8_t RTTP_MAX_CLIENTS           = 10;
 const String RTTP_CHANNEL                = F("kiro");
 const String RTTP_TOPIC_DEVICE           = F("device");
 const String RTTP_TOPIC_PRAYER_GROUP     = F("prayer-group");
@@ -107,6 +128,7 @@ const String TAG_BUTTON    = F("Button");
 const String TAG_SYSTEM    = F("System");
 const String TAG_PRAYER    = F("Prayer");
 const String TAG_SIMULATOR = F("Simulator");
+const String TAG_BENCHMARK = F("Benchmark");
 
 /*----- Instances ------*/
 TinyDB g_DB;
@@ -114,7 +136,7 @@ AsyncUDP g_UDP;
 DFRobotDFPlayerMini g_DFPlayer;
 Adafruit_SSD1306 g_OLED(128, 64);
 AsyncUDPMessage g_UDPMessage;
-RTTP::Server g_Server(80);
+RTTP::Server g_Server(80, RTTP_MAX_CLIENTS);
 Button g_Button(PIN_BUTTON);
 Button g_DFBusy(PIN_DF_BUSY);
 Output g_Relay(PIN_RELAY);
@@ -146,12 +168,15 @@ SurahAudio g_SurahPreview;
 SurahCollection g_SurahCollection;
 
 UniTime::Date g_LastPrayerUpdateDate;
-std::vector<std::function<void()>> g_MainThreadQueue;
-SemaphoreHandle_t g_MainThreadQueueMutex = xSemaphoreCreateMutex();
+WorkQueue<MAIN_QUEUE_CAPACITY> g_MainThreadQueue;
+
+Sequence g_AudioSequence;
+Sequence::Event g_AudioStarted;
 
-CountDownTimer g_AudioTimeoutTimer;
-CountDownTimer g_AudioPlayTimer;
+// The OLED and the RTC share the I2C bus, and the OLED sends its frames from its own task.
+SemaphoreHandle_t g_WireLock = NULL;
 
 bool g_IsQiroCancelled = false;
+std::atomic<uint32_t> g_DisplayFrames(0);
 
 #endif
@@ -18,6 +18,9 @@ String deviceNames;
 int16_t xSurah  = 0;
 int16_t xDevice = 0;
 
+std::vector<uint8_t> surahStrip;
+std::vector<uint8_t> deviceStrip;
+
 bool isSurahScrolling  = false;
 bool isDeviceScrolling = false;
 bool isShowingDateTime = false;
@@ -45,6 +48,60 @@ void clearDisplay(const uint16_t& start, const uint16_t& height) {
     g_OLED.fillRect(0, start, g_OLED.width(), height, SSD1306_BLACK);
 }
 
+/**
+ * @brief Render a line of text once into a strip of 8-pixel columns, so scrolling it
+ * only copies the visible part instead of drawing every character again.
+ *
+ * @param text is the text, drawn with a text size of 1.
+ * @param strip is where the columns are stored, bit 0 at the top.
+ */
+void renderStrip(const String& text, std::vector<uint8_t>& strip) {
+    int16_t width = min(text.length() * 6, (size_t)INT16_MAX);
+    GFXcanvas1 canvas(width, 8);
+    strip.assign(width, 0);
+    if (!canvas.getBuffer()) {
+        return;
+    }
+
+    canvas.setTextWrap(false);
+    canvas.setTextColor(1);
+    canvas.setCursor(0, 0);
+    canvas.print(text);
+    for (int16_t x = 0; x < width; x++) {
+        for (uint8_t y = 0; y < 8; y++) {
+            if (canvas.getPixel(x, y)) {
+                strip[x] |= 1 << y;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Move a rendered strip one pixel to the left, wrapping around to the right edge.
+ * It only draws, so both lines can be sent in one frame.
+ *
+ * @param strip is the strip.
+ * @param x is the position of the strip, updated.
+ * @param y is the top row of the line.
+ */
+void scrollStrip(const std::vector<uint8_t>& strip, int16_t& x, const int16_t& y) {
+    if (x <= -(int16_t)strip.size()) {
+        x = g_OLED.width();
+    } else {
+        x--;
+    }
+
+    // The strip replaces what is under it, so only the rest of the line is cleared.
+    int16_t end = x + (int16_t)strip.size();
+    if (x > 0) {
+        g_OLED.fillRect(0, y, x, 8, SSD1306_BLACK);
+    }
+    if (end < g_OLED.width()) {
+        g_OLED.fillRect(max(end, (int16_t)0), y, g_OLED.width() - max(end, (int16_t)0), 8, SSD1306_BLACK);
+    }
+    g_OLED.drawColumns(x, y, strip.data(), strip.size());
+}
+
 String getSurahName(uint16_t index) {
     index        = constrain(index - 1, 0, g_SurahCollection.totalSize - 1);
     String surah = String(COLLECTIONS[index]);
@@ -116,8 +173,10 @@ void showSurahOngoing() {
     if (getTextWidth(surahNames) > g_OLED.width()) {
         isSurahScrolling = true;
         xSurah           = g_OLED.width();
+        renderStrip(surahNames, surahStrip);
     } else {
         isSurahScrolling = false;
+        std::vector<uint8_t>().swap(surahStrip);
         centerHorizontal(surahNames, 44);
     }
 
@@ -135,7 +194,7 @@ void showConnectedDevice() {
     for (const auto& client : g_Server.getSubscribers(RTTP_CHANNEL)) {
         if (!client.name.isEmpty()) {
             if (first) {
-                first = true;
+                first = false;
             } else {
                 deviceNames += ", ";
             }
@@ -151,8 +210,10 @@ void showConnectedDevice() {
     if (getTextWidth(deviceNames) > g_OLED.width()) {
         isDeviceScrolling = true;
         xDevice           = g_OLED.width();
+        renderStrip(deviceNames, deviceStrip);
     } else {
         isDeviceScrolling = false;
+        std::vector<uint8_t>().swap(deviceStrip);
         centerHorizontal(deviceNames, 56);
     }
 
@@ -218,36 +279,14 @@ void scrollDisplay() {
     }
 
     if (isSurahScrolling) {
-        clearDisplay(44, 8);
-        g_OLED.setTextSize(1);
-        g_OLED.setTextWrap(false);
-
-        if (xSurah <= -getTextWidth(surahNames)) {
-            xSurah = g_OLED.width();
-        } else {
-            xSurah--;
-        }
-
-        g_OLED.setCursor(xSurah, 44);
-        g_OLED.print(surahNames);
-        g_OLED.display();
+        scrollStrip(surahStrip, xSurah, 44);
     }
 
     if (isDeviceScrolling) {
-        clearDisplay(56, 8);
-        g_OLED.setTextSize(1);
-        g_OLED.setTextWrap(false);
-
-        if (xDevice <= -getTextWidth(deviceNames)) {
-            xDevice = g_OLED.width();
-        } else {
-            xDevice--;
-        }
-
-        g_OLED.setCursor(xDevice, 56);
-        g_OLED.print(deviceNames);
-        g_OLED.display();
+        scrollStrip(deviceStrip, xDevice, 56);
     }
+
+    g_OLED.display();
 }
 
 };  // namespace Display
@@ -32,10 +32,20 @@ void onButtonPressed() {
     Log::debug(TAG_BUTTON, "Pressed");
 }
 
+/*----- Display -----*/
+
+/**
+ * @brief Count the frames sent to the display. It runs on the task sending them.
+ *
+ */
+void onDisplayFrame() {
+    g_DisplayFrames.fetch_add(1, std::memory_order_relaxed);
+}
+
 /*----- Audio -----*/
 
 void onStartPlayingAudio() {
-    g_AudioTimeoutTimer.cancel();
+    g_AudioStarted.trigger();
 }
 
 void onFinishedPlayingAudio() {
@@ -122,15 +132,17 @@ void initializeDatabase() {
     Log::info(TAG_VERSION, F("Kiro v%s"), VERSION);
     Log::info(TAG_DATABASE, F("Initializing..."));
 
+    uint32_t start = millis();
     while (!SPIFFS.begin(true)) {
         delay(1000);
         Serial.print(".");
     }
 
-    g_DB.begin(SPIFFS);
+    g_DB.begin(SPIFFS, TinyDB::Log);
+    g_DB.setWriteBehind(DB_WRITE_BEHIND_DELAY);
     Config::initialize();
     loadDatabase();
-    Log::info(TAG_DATABASE, F("Database has been initialized"));
+    Log::info(TAG_DATABASE, F("Database has been initialized in %lu ms"), millis() - start);
 }
 
 /*----- Discovery Service -----*/
@@ -213,11 +225,15 @@ void initializeNetwork() {
     Log::info(TAG_WIFI, F("STA MAC Address: %s"), WiFi.macAddress().c_str());
 }
 
+void reconnectWiFi() {
+    if (!WiFi.isConnected()) {
+        reconnectSTA();
+    }
+}
+
 void reconnectionTask(void*) {
     while (true) {
-        if (!WiFi.isConnected()) {
-            reconnectSTA();
-        }
+        reconnectWiFi();
         delay(10000);
     }
 }
@@ -225,20 +241,61 @@ void reconnectionTask(void*) {
 /*----- Task -----*/
 
 void runMainQueue() {
-    if (g_MainThreadQueue.empty()) {
-        return;
+    g_MainThreadQueue.run();
+}
+
+void reportLoopStatistics() {
+    Timer::Statistics statistics = Timer::getStatistics();
+    Log::debug(
+        TAG_SYSTEM, "Idle: %u%%, wake-ups: %u, jitter: %u us avg, %u us max", statistics.getIdlePercentage(),
+        statistics.wakeUps, statistics.getAverageJitterMicros(), statistics.maxJitterMicros
+    );
+    Timer::resetStatistics();
+
+    uint32_t replacedStack = 0;
+    for (const Executor::Statistics& job : Executor::getStatistics()) {
+        replacedStack += job.replacedStack;
+#if EXECUTOR_PROFILING
+        Log::debug(
+            TAG_SYSTEM, "Job %s: %u runs, %u us max, %u B stack", job.name, job.runs, job.maxMicros, job.stackUsage
+        );
+#else
+        Log::debug(TAG_SYSTEM, "Job %s: %u runs, %u us max", job.name, job.runs, job.maxMicros);
+#endif
+    }
+    if (Executor::isRunning()) {
+        Log::debug(
+            TAG_SYSTEM, "Executor: %u B of task stacks in %u B, free heap: %u B", replacedStack,
+            Executor::getStackSize(), ESP.getFreeHeap()
+        );
     }
 
-    xSemaphoreTake(g_MainThreadQueueMutex, portMAX_DELAY);
-    std::vector<std::function<void()>> queue = g_MainThreadQueue;
-    g_MainThreadQueue.clear();
-    xSemaphoreGive(g_MainThreadQueueMutex);
+    Log::debug(TAG_SYSTEM, "Display: %u frames", g_DisplayFrames.exchange(0, std::memory_order_relaxed));
 
-    for (auto& runnable : queue) {
-        if (runnable) {
-            runnable();
+    if (g_MainThreadQueue.getOverflowCount() > 0) {
+        Log::debug(TAG_SYSTEM, "Main queue overflows: %u", g_MainThreadQueue.getOverflowCount());
+        g_MainThreadQueue.resetOverflowCount();
+    }
+
+#if TIMER_PROFILING
+    Timer::LoopProfile loop = Timer::getLoopProfile();
+    Log::debug(
+        TAG_SYSTEM, "Loop: %u us avg, %u us max, slowest call: %s (%u us)", loop.getAverageMicros(), loop.maxMicros,
+        loop.slowestName ? loop.slowestName : "unnamed", loop.slowestMicros
+    );
+
+    ArrayList<Timer::Profile> profiles = Timer::getProfiles();
+    for (size_t i = 0; i < profiles.size(); i++) {
+        Timer::Profile& profile = profiles[i];
+        if (profile.calls > 0 && profile.name) {
+            Log::debug(
+                TAG_SYSTEM, "%s: %u calls, %u us avg, %u us max, %u ms late max", profile.name, profile.calls,
+                profile.getAverageMicros(), profile.maxMicros, profile.maxLateness
+            );
         }
     }
+    Timer::resetProfiles();
+#endif
 }
 
 #endif
\ No newline at end of file
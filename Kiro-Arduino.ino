@@ -9,6 +9,11 @@
 #pragma message("Simulation mode is enabled")
 #endif
 
+#if BENCHMARK
+#include "Benchmark.h"
+#pragma message("Benchmark mode is enabled")
+#endif
+
 void setup() {
     checkCounterfeit();
     Serial1.begin(9600, SERIAL_8N1, PIN_DF_RX, PIN_DF_TX);
@@ -17,8 +22,14 @@ void setup() {
     delay(1000);
     Log::attach(Serial, Log::Debug);
 #endif
+    Executor::begin(EXECUTOR_STACK_SIZE);
     g_DFPlayer.begin(Serial1);
+    g_WireLock = xSemaphoreCreateRecursiveMutex();
+    g_OLED.setBusLock(g_WireLock);
+    Time.setBusLock(g_WireLock);
     g_OLED.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    g_OLED.beginAsync();
+    g_OLED.onFrame(onDisplayFrame);
     g_Button.begin();
     g_DFBusy.begin();
     g_Relay.begin(false);
@@ -28,6 +39,9 @@ void setup() {
     g_DFBusy.onRelease(onFinishedPlayingAudio);
 
     initializeDatabase();
+#if BENCHMARK
+    Benchmark::run();
+#endif
     initializeNetwork();
 
     g_Server.createChannel(RTTP_CHANNEL)
@@ -66,10 +80,18 @@ void setup() {
     Display::showBootMessage();
     Log::info(TAG_SYSTEM, Any(getMacAddressInt()).toString());
 
-    Timer::setInterval(10000, Display::switchDisplay);
-    Timer::setInterval(50, Display::scrollDisplay);
-    Timer::registerEvent(runMainQueue);
-    xTaskCreate(reconnectionTask, "reconnectionTask", 4096, NULL, 5, NULL);
+    Timer::setName(Timer::setInterval(10000, Display::switchDisplay), "switchDisplay");
+    Timer::setName(Timer::setInterval(50, Display::scrollDisplay), "scrollDisplay");
+    g_AudioSequence.setBody(runAudioSequence);
+    g_AudioSequence.setName("audio");
+#if DEBUG
+    Timer::setInterval(60000, reportLoopStatistics);
+#endif
+    if (Executor::isRunning()) {
+        Executor::add("reconnection", 10000, reconnectWiFi, 4096);
+    } else {
+        xTaskCreate(reconnectionTask, "reconnectionTask", 4096, NULL, 5, NULL);
+    }
 
 #if SIMULATION
     Simulation::initialize();
@@ -78,6 +100,7 @@ void setup() {
 
 void loop() {
     Timer::run();
+    runMainQueue();
 
 #if SIMULATION
     if (Serial.available()) {
@@ -97,4 +120,15 @@ void loop() {
         }
     }
 #endif
+
+    // Sleep until the next timer is due or work is posted to the main loop.
+    // Work posted by the main loop itself does not notify it, so the queue is checked first.
+    if (!g_MainThreadQueue.isEmpty()) {
+        return;
+    }
+#if SIMULATION
+    Timer::wait(100);
+#else
+    Timer::wait();
+#endif
 }
\ No newline at end of file
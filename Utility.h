@@ -13,10 +13,38 @@
 
 /*----- Task -----*/
 
-void post(const std::function<void()>& runnable) {
-    xSemaphoreTake(g_MainThreadQueueMutex, portMAX_DELAY);
-    g_MainThreadQueue.push_back(runnable);
-    xSemaphoreGive(g_MainThreadQueueMutex);
+/**
+ * @brief Run a function on the main loop. It is safe to call from any task.
+ *
+ * @param runnable is the function.
+ * @return false if the queue is full.
+ */
+template <typename Runnable>
+bool post(Runnable&& runnable) {
+    if (!g_MainThreadQueue.push(std::forward<Runnable>(runnable))) {
+        Log::error(TAG_SYSTEM, "The main queue is full");
+        return false;
+    }
+    Timer::wake();
+    return true;
+}
+
+/**
+ * @brief Run a function on the main loop, unless a function with the same key is already pending.
+ * Use it for refreshes that read the current state, so a burst of changes refreshes once.
+ *
+ * @param key is one of the POST_* keys.
+ * @param runnable is the function.
+ * @return false if the queue is full.
+ */
+template <typename Runnable>
+bool post(const uint8_t& key, Runnable&& runnable) {
+    if (!g_MainThreadQueue.push(key, std::forward<Runnable>(runnable))) {
+        Log::error(TAG_SYSTEM, "The main queue is full");
+        return false;
+    }
+    Timer::wake();
+    return true;
 }
 
 /*----- WiFi -----*/
@@ -24,7 +52,7 @@ void post(const std::function<void()>& runnable) {
 void restartAP() {
     Setting& password = g_Security.getSetting(Config::SECURITY_PASSWORD);
     WiFi.softAPdisconnect();
-    WiFi.softAP(g_Device.name.c_str(), password.value.c_str());
+    WiFi.softAP(g_Device.name.c_str(), password.value.c_str(), 1, 0, RTTP_MAX_CLIENTS);
 }
 
 void reconnectSTA() {
@@ -131,8 +159,8 @@ void updatePrayerQiroOngoing(UniTime::DateTime dateTime) {
         g_QiroOngoing   = qiroGroup.getQiro(activePrayer.name);
         publish(RTTP_TOPIC_PRAYER_ONGOING, g_PrayerOngoing);
         publish(RTTP_TOPIC_QIRO_ONGOING, g_QiroOngoing);
-        post(Display::showPrayerOngoing);
-        post(Display::showSurahOngoing);
+        post(POST_SHOW_PRAYER_ONGOING, Display::showPrayerOngoing);
+        post(POST_SHOW_SURAH_ONGOING, Display::showSurahOngoing);
         g_IsQiroCancelled = false;
         Log::info(
             TAG_PRAYER, "Ongoing: %s %s (%s)", g_PrayerOngoing.getNameString().c_str(),
@@ -177,6 +205,32 @@ void checkPrayerTime() {
 
 /*----- Audio -----*/
 
+/**
+ * @brief Start the ongoing surah: power the amplifier and let it settle, then play
+ * the surah and wait for the busy pin. It skips to the next surah if the player
+ * does not start in time.
+ *
+ * @param sequence is g_AudioSequence.
+ */
+void runAudioSequence(Sequence& sequence) {
+    SEQUENCE_BEGIN(sequence);
+    if (!g_Relay.get()) {
+        g_Relay.set(true);
+        SEQUENCE_DELAY(sequence, 5000);
+    }
+
+    g_AudioStarted.reset();
+    g_DFPlayer.volume(g_SurahOngoing.volume);
+    g_DFPlayer.play(g_SurahOngoing.id);
+    SEQUENCE_AWAIT(sequence, g_AudioStarted, 5000);
+
+    if (sequence.isTimedOut()) {
+        Log::error(TAG_AUDIO, "Timed out waiting for audio to start");
+        playNextSurah();
+    }
+    SEQUENCE_END(sequence);
+}
+
 void playNextSurah(bool fromStart) {
     static uint16_t index = 0;
     index                 = fromStart ? 0 : index + 1;
@@ -191,32 +245,13 @@ void playNextSurah(bool fromStart) {
     g_SurahOngoing.isPlaying = true;
     g_SurahOngoing.isPaused  = false;
 
-    g_AudioTimeoutTimer.setDuration(5000);
-    g_AudioTimeoutTimer.setHandler([]() {
-        Log::error(TAG_AUDIO, "Timed out waiting for audio to start");
-        playNextSurah();
-    });
-
-    if (!g_Relay.get()) {
-        g_Relay.set(true);
-        g_AudioPlayTimer.setDuration(5000);
-        g_AudioPlayTimer.setHandler([surah]() {
-            g_AudioTimeoutTimer.start();
-            g_DFPlayer.volume(surah.volume);
-            g_DFPlayer.play(surah.id);
-        });
-        g_AudioPlayTimer.start();
-    } else {
-        g_AudioTimeoutTimer.start();
-        g_DFPlayer.volume(surah.volume);
-        g_DFPlayer.play(surah.id);
-    }
+    g_AudioSequence.start();
 
     publish(RTTP_TOPIC_SURAH_ONGOING, g_SurahOngoing);
 
     Display::isQiroActive = false;
-    post(Display::showPrayerOngoing);
-    post(Display::showSurahOngoing);
+    post(POST_SHOW_PRAYER_ONGOING, Display::showPrayerOngoing);
+    post(POST_SHOW_SURAH_ONGOING, Display::showSurahOngoing);
     Log::info(TAG_AUDIO, "Playing %d - %s", surah.id, Display::getSurahName(surah.id).c_str());
 }
 
@@ -271,16 +306,15 @@ void playPreviewAudio(const SurahAudio& audio) {
 }
 
 void forceStopAudio() {
-    g_AudioPlayTimer.cancel();
-    g_AudioTimeoutTimer.cancel();
+    g_AudioSequence.cancel();
     Display::isQiroActive    = false;
     g_SurahOngoing.isPlaying = false;
     g_SurahOngoing.isPaused  = false;
     g_DFPlayer.stop();
     g_Relay.set(false);
     publish(RTTP_TOPIC_SURAH_ONGOING, g_SurahOngoing);
-    post(Display::showPrayerOngoing);
-    post(Display::showSurahOngoing);
+    post(POST_SHOW_PRAYER_ONGOING, Display::showPrayerOngoing);
+    post(POST_SHOW_SURAH_ONGOING, Display::showSurahOngoing);
     Log::info(TAG_AUDIO, "Stopped");
 }
 
@@ -45,12 +45,12 @@ void onAuthenticated(const RTTP::Auth& auth) {
     g_Server.send(auth.id, RTTP_CHANNEL, RTTP_TOPIC_SURAH_ONGOING, RTTP::Message::Set, g_SurahOngoing);
     g_Server.send(auth.id, RTTP_CHANNEL, RTTP_TOPIC_SURAH_PREVIEW, RTTP::Message::Set, g_SurahPreview);
     g_Server.send(auth.id, RTTP_CHANNEL, RTTP_TOPIC_DEVICE, RTTP::Message::Set, g_Device);
-    post(Display::showConnectedDevice);
+    post(POST_SHOW_CONNECTED_DEVICE, Display::showConnectedDevice);
 }
 
 void onLeave(const String& ip, const uint16_t& port, const uint8_t& count) {
     Log::info(TAG_RTTP, "Client left: %s:%d (%d)", ip.c_str(), port, count);
-    post(Display::showConnectedDevice);
+    post(POST_SHOW_CONNECTED_DEVICE, Display::showConnectedDevice);
 }
 
 void onTopicPrayerOffset(const RTTP::Message& message) {
@@ -204,25 +204,44 @@ void onTopicSurahForceStop(const RTTP::Message& message) {
     }
 }
 
+/**
+ * @brief Stream a batch of the surah list to a client, then schedule the next batch.
+ * The batches are paced by the timer, so the task that polls the server is not blocked.
+ *
+ * @param recipientId is the id of the client.
+ * @param progress is the index of the first surah of the batch.
+ */
+void streamSurahList(const String& recipientId, const uint16_t& progress) {
+    uint16_t total = g_SurahCollection.totalSize;
+    uint16_t size  = min((uint16_t)(total - progress), SURAH_LIST_BATCH_SIZE);
+
+    bool isSent = g_Server.stream(
+        recipientId, RTTP_CHANNEL, RTTP_TOPIC_SURAH_LIST, RTTP::Message::Set,
+        [progress, size](Print& printer) {
+            printer.print(AnyParser::ARRAY_OPEN_BRACKET);
+            for (uint16_t i = progress; i < progress + size; i++) {
+                if (i > progress) {
+                    printer.print(AnyParser::SEPARATOR);
+                }
+                printer.print(COLLECTIONS[i]);
+            }
+            printer.print(AnyParser::ARRAY_CLOSE_BRACKET);
+        }
+    );
+
+    uint16_t next = progress + size;
+    if (isSent && next < total) {
+        Timer::setTimeout(SURAH_LIST_BATCH_DELAY, [recipientId, next]() { streamSurahList(recipientId, next); });
+    }
+}
+
 void onTopicSurahList(const RTTP::Message& message) {
     if (message.recipientId != RTTP::SERVER_ID || message.action != RTTP::Message::Get) {
         return;
     }
 
-    uint16_t progress = 0;
-    uint16_t total    = g_SurahCollection.totalSize;
-
-    while (progress < total) {
-        uint16_t size = min(total - progress, 10);
-        Array surahList;
-
-        for (uint16_t i = progress; i < progress + size; i++) {
-            surahList.push(Raw(COLLECTIONS[i]));
-        }
-
-        g_Server.send(message.senderId, RTTP_CHANNEL, message.topic, RTTP::Message::Set, surahList);
-        progress += size;
-        delay(100);
+    if (g_SurahCollection.totalSize > 0) {
+        streamSurahList(message.senderId, 0);
     }
 }
 
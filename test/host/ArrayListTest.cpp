@@ -0,0 +1,233 @@
+#include <ArrayList/ArrayList.h>
+#include <Host.h>
+#include <UnitTest/UnitTest.h>
+
+#include <set>
+#include <vector>
+
+/**
+ * This test keeps elements in ArrayLists with inline storage and counts their
+ * lifetimes. Every element records its address when it is constructed and removes
+ * it when it is destroyed, so an element destroyed twice, never constructed or never
+ * destroyed is found. Each case grows, shrinks, removes from, copies and moves lists
+ * held inline and on the heap, then checks the values and that every element
+ * constructed was destroyed exactly once.
+ */
+
+namespace {
+
+const size_t INLINE_CAPACITY = 4;
+
+std::set<const void*> alive;
+uint32_t errors = 0;
+
+/**
+ * @brief An element that tracks its lifetime. A moved-from element holds -1.
+ *
+ */
+struct Tracked {
+    int value;
+
+    Tracked(const int& value = 0)
+        : value(value) {
+        construct();
+    }
+
+    Tracked(const Tracked& other)
+        : value(other.value) {
+        other.check();
+        construct();
+    }
+
+    Tracked(Tracked&& other) noexcept
+        : value(other.value) {
+        other.check();
+        other.value = -1;
+        construct();
+    }
+
+    Tracked& operator=(const Tracked& other) {
+        check();
+        other.check();
+        value = other.value;
+        return *this;
+    }
+
+    Tracked& operator=(Tracked&& other) noexcept {
+        check();
+        other.check();
+        value       = other.value;
+        other.value = -1;
+        return *this;
+    }
+
+    ~Tracked() {
+        if (alive.erase(this) == 0) {
+            errors++;
+        }
+    }
+
+    bool operator==(const Tracked& other) const {
+        return value == other.value;
+    }
+
+   private:
+    void construct() {
+        if (!alive.insert(this).second) {
+            errors++;
+        }
+    }
+
+    void check() const {
+        if (alive.count(this) == 0) {
+            errors++;
+        }
+    }
+};
+
+using List = ArrayList<Tracked, INLINE_CAPACITY>;
+
+List make(const int& count) {
+    List list;
+    for (int i = 0; i < count; i++) {
+        list.add(Tracked(i));
+    }
+    return list;
+}
+
+bool isInline(List& list) {
+    const char* element = (const char*)&list[0];
+    return element >= (const char*)&list && element < (const char*)(&list + 1);
+}
+
+bool hasValues(List& list, const std::vector<int>& values) {
+    if (list.size() != values.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < values.size(); i++) {
+        if (list[i].value != values[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Run a case and check that its elements were all destroyed once.
+ *
+ * @param test is the unit test to add the assertions to.
+ * @param name is the name of the case.
+ * @param run runs the case and returns true if the lists held the expected values.
+ */
+template <class Case>
+void check(UnitTest& test, const String& name, Case run) {
+    errors         = 0;
+    bool isCorrect = run();
+    test.assertTrue("ArrayList_" + name + "_Values", isCorrect);
+    test.assertEqual("ArrayList_" + name + "_NoDoubleDestruction", 0, errors);
+    test.assertEqual("ArrayList_" + name + "_Balanced", 0, alive.size());
+    alive.clear();
+}
+
+};  // namespace
+
+int main() {
+    UnitTest list("ArrayList Unit Test");
+
+    check(list, "GrowsPastInline", []() {
+        List values = make(10);
+        return hasValues(values, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}) && !isInline(values);
+    });
+
+    check(list, "ResizesIntoInline", []() {
+        List values = make(10);
+        values.resize(3);
+        bool isShrunk = hasValues(values, {0, 1, 2}) && isInline(values);
+        values.resize(0);
+        return isShrunk && values.isEmpty();
+    });
+
+    check(list, "RemovesAtInline", []() {
+        List values = make(3);
+        values.removeAt(0);
+        values.removeAt(5);
+        return hasValues(values, {1, 2}) && isInline(values);
+    });
+
+    check(list, "RemovesAtHeap", []() {
+        List values = make(8);
+        values.removeAt(3);
+        values.removeAt(6);
+        return hasValues(values, {0, 1, 2, 4, 5, 6});
+    });
+
+    check(list, "RemovesIfInline", []() {
+        List values = make(4);
+        values.removeIf([](const Tracked& element) { return element.value % 2 == 0; });
+        return hasValues(values, {1, 3});
+    });
+
+    check(list, "RemovesIfHeap", []() {
+        List values = make(9);
+        values.removeIf([](const Tracked& element) { return element.value % 3 != 0; });
+        return hasValues(values, {0, 3, 6});
+    });
+
+    check(list, "CopiesFromInlineAndHeap", []() {
+        List small = make(2), large = make(7);
+        List target   = make(6);
+        target        = small;
+        bool isCopied = hasValues(target, {0, 1}) && hasValues(small, {0, 1});
+
+        target   = large;
+        isCopied = isCopied && hasValues(target, {0, 1, 2, 3, 4, 5, 6}) && hasValues(large, {0, 1, 2, 3, 4, 5, 6});
+        target   = target;
+        List copy(large);
+        return isCopied && hasValues(target, {0, 1, 2, 3, 4, 5, 6}) && hasValues(copy, {0, 1, 2, 3, 4, 5, 6});
+    });
+
+    check(list, "MovesFromInline", []() {
+        List source = make(3);
+        List target(std::move(source));
+        bool isMoved = hasValues(target, {0, 1, 2}) && source.isEmpty();
+        List other   = make(6);
+        other        = std::move(target);
+        isMoved      = isMoved && hasValues(other, {0, 1, 2}) && target.isEmpty();
+        source.add(Tracked(9));
+        return isMoved && hasValues(source, {9});
+    });
+
+    check(list, "MovesFromHeap", []() {
+        List source = make(6);
+        List target(std::move(source));
+        bool isMoved = hasValues(target, {0, 1, 2, 3, 4, 5}) && source.isEmpty();
+        List other   = make(2);
+        other        = std::move(target);
+        isMoved      = isMoved && hasValues(other, {0, 1, 2, 3, 4, 5}) && target.isEmpty();
+        target.add(Tracked(9));
+        return isMoved && hasValues(target, {9});
+    });
+
+    check(list, "AddsOwnElementWhileGrowing", []() {
+        List values = make(INLINE_CAPACITY);
+        values.add(values[0]);
+        bool isAdded = hasValues(values, {0, 1, 2, 3, 0}) && !isInline(values);
+        while (values.size() < 6) {
+            values.add(Tracked(values.size()));
+        }
+        values.add(values[5]);
+        return isAdded && hasValues(values, {0, 1, 2, 3, 0, 5, 5});
+    });
+
+    check(list, "AddsAllAndClears", []() {
+        List values = make(3), more = make(3);
+        values.addAll(more);
+        bool isAdded = hasValues(values, {0, 1, 2, 0, 1, 2});
+        values.clear();
+        return isAdded && values.isEmpty() && isInline(more);
+    });
+
+    list.attach(Host::console);
+    UnitTest::Result result = list.run();
+    return result.failed > 0;
+}
@@ -0,0 +1,30 @@
+#include <Host.h>
+
+#include "Config.h"
+#include "Benchmark.h"
+
+/**
+ * This program runs the benchmarks of Benchmark.h on the host and prints their reports.
+ *
+ * The storage workloads replay the database against FlashSimulator on the stopped clock,
+ * so the waits of the workloads take no time and a latency is the simulated flash time
+ * of the operation. The network workload sends its bursts to TCPSimulator on the same
+ * clock, so a latency is the simulated time of lwIP and of the wire. The reports are
+ * the same from one run to the next.
+ *
+ * The queue workload posts from three tasks while the main task drains, so it runs on
+ * the real clock and its latencies vary from run to run.
+ */
+
+int main() {
+    Log::attach(Host::console, Log::Info);
+    Config::initialize();
+
+    Host::setTime(0);
+    Benchmark::runStorage();
+    Benchmark::runNetwork();
+
+    Host::useRealTime();
+    Benchmark::runQueues();
+    return 0;
+}
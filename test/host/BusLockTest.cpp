@@ -0,0 +1,131 @@
+#include <Host.h>
+#include <Wire.h>
+#include <Adafruit/SSD1306/Adafruit_SSD1306.h>
+#include <Time/Time.h>
+#include <UnitTest/UnitTest.h>
+
+#include <atomic>
+
+/**
+ * This test reads the RTC on the main task while the display sends its frames from
+ * its own task, as the firmware does, on a bus where a frame takes as long as at
+ * 400 kHz. The models on the bus count the RTC transfers made at the display clock,
+ * which means in the middle of a frame, and the display transmissions that split
+ * the two transmissions of an RTC register read. Build it with HOST_SANITIZE_THREAD
+ * to run it under ThreadSanitizer.
+ */
+
+namespace {
+
+const uint8_t DISPLAY_ADDRESS = 0x3C;
+const uint8_t RTC_ADDRESS     = 0x68;
+const uint32_t BUS_CLOCK      = 100000;
+const uint32_t TIMESTAMP      = 1700000000;
+
+std::atomic<bool> isReadPending(false);
+std::atomic<uint32_t> fastTransfers(0);
+std::atomic<uint32_t> splitReads(0);
+
+/**
+ * @brief A DS3231 that keeps its registers still.
+ *
+ */
+class Clock : public I2CDevice {
+   public:
+    void receive(const uint8_t* data, const size_t& size, const uint32_t& clock) override {
+        check(clock);
+        if (size == 0) return;
+        m_Pointer = data[0];
+        for (size_t i = 1; i < size; i++) {
+            m_Registers[m_Pointer++ % sizeof(m_Registers)] = data[i];
+        }
+        isReadPending = size == 1;
+    }
+
+    size_t transmit(uint8_t* data, const size_t& size, const uint32_t& clock) override {
+        check(clock);
+        isReadPending = false;
+        for (size_t i = 0; i < size; i++) {
+            data[i] = m_Registers[m_Pointer++ % sizeof(m_Registers)];
+        }
+        return size;
+    }
+
+   private:
+    uint8_t m_Registers[0x13] = {};
+    uint8_t m_Pointer         = 0;
+
+    void check(const uint32_t& clock) {
+        if (clock != BUS_CLOCK) fastTransfers++;
+    }
+};
+
+/**
+ * @brief A display that takes as long as the bytes take at the clock of the bus.
+ *
+ */
+class Panel : public I2CDevice {
+   public:
+    void receive(const uint8_t* data, const size_t& size, const uint32_t& clock) override {
+        if (isReadPending) splitReads++;
+        delayMicroseconds(size * 9 * 1000000ULL / clock);
+    }
+};
+
+/**
+ * @brief Draw and display frames, reading the RTC after each one while the frame is sent.
+ *
+ * @return the number of reads made while a frame was being sent.
+ */
+uint32_t run(Adafruit_SSD1306& display, UniTime::DS3231& rtc, bool& isTimeCorrect) {
+    uint32_t overlaps = 0;
+    for (uint16_t frame = 0; frame < 100; frame++) {
+        display.fillRect(frame % 96, 8 * (frame % 6), 32, 16, SSD1306_INVERSE);
+        display.display();
+        if (display.isTransferring()) overlaps++;
+        isTimeCorrect = isTimeCorrect && rtc.timestamp() == TIMESTAMP;
+        isTimeCorrect = isTimeCorrect && !rtc.lostPower();
+    }
+    display.waitForTransfer();
+    return overlaps;
+}
+
+};  // namespace
+
+int main() {
+    UnitTest busLock("BusLock Unit Test");
+
+    Clock clock;
+    Panel panel;
+    Wire.attach(RTC_ADDRESS, &clock);
+    Wire.attach(DISPLAY_ADDRESS, &panel);
+
+    SemaphoreHandle_t lock = xSemaphoreCreateRecursiveMutex();
+    Adafruit_SSD1306 display(128, 64);
+    UniTime::DS3231 rtc;
+    display.setBusLock(lock);
+    rtc.setBusLock(lock);
+
+    display.begin(SSD1306_SWITCHCAPVCC, DISPLAY_ADDRESS);
+    rtc.begin();
+    rtc.adjust(TIMESTAMP);
+    busLock.assertTrue("BusLock_DisplayStartsAsync", display.beginAsync());
+
+    bool isTimeCorrect = true;
+    uint32_t overlaps  = run(display, rtc, isTimeCorrect);
+    busLock.assertTrue("BusLock_RtcRunsWhileFramesAreSent", overlaps > 0);
+    busLock.assertTrue("BusLock_RtcReadsTheTime", isTimeCorrect);
+    busLock.assertEqual("BusLock_RtcNeverRunsAtDisplayClock", 0, fastTransfers.load());
+    busLock.assertEqual("BusLock_RtcReadsAreNeverSplit", 0, splitReads.load());
+
+    // Without the lock, the bus only keeps each transmission whole, which the test must notice.
+    display.setBusLock(NULL);
+    rtc.setBusLock(NULL);
+    fastTransfers = 0;
+    run(display, rtc, isTimeCorrect);
+    busLock.assertTrue("BusLock_WithoutLockRtcRunsAtDisplayClock", fastTransfers > 0);
+
+    busLock.attach(Host::console);
+    UnitTest::Result result = busLock.run();
+    return result.failed > 0;
+}
@@ -0,0 +1,170 @@
+#include <Host.h>
+#include <Button/Button.h>
+#include <UnitTest/UnitTest.h>
+
+/**
+ * This test drives a button through edge sequences on a stopped clock. It stands in
+ * for the Executor to capture the job of the buttons and the delay they schedule,
+ * so every run of the job happens at an exact time.
+ */
+
+namespace {
+
+const uint8_t PIN = 5;
+
+Executor::Job job;
+uint32_t scheduled = 0;
+String events;
+
+/**
+ * @brief Run the job of the buttons at a time.
+ *
+ * @param time is the time in milliseconds.
+ */
+void runAt(const uint32_t& time) {
+    Host::setTime(time);
+    job();
+}
+
+/**
+ * @brief Change the level of the pin at a time. The button is pulled up, so LOW is pressed.
+ *
+ * @param time is the time in milliseconds.
+ * @param level is the level.
+ * @param isInterrupted is false to miss the edge.
+ */
+void edgeAt(const uint32_t& time, const uint8_t& level, const bool& isInterrupted = true) {
+    Host::setTime(time);
+    Host::setPin(PIN, level, isInterrupted);
+}
+
+/**
+ * @brief Get the events since the last call, as their letter and time separated by spaces.
+ *
+ */
+String takeEvents() {
+    String taken = events;
+    events       = "";
+    return taken;
+}
+
+void record(const char* event) {
+    events += event + String(millis()) + " ";
+}
+
+};  // namespace
+
+bool Executor::isRunning() {
+    return true;
+}
+
+int8_t Executor::add(const char* name, const uint32_t& interval, const Job& job, const uint32_t& replacedStack) {
+    ::job = job;
+    return 0;
+}
+
+void Executor::notify(const int8_t& jobId) {}
+
+void Executor::notifyFromISR(const int8_t& jobId) {}
+
+void Executor::schedule(const int8_t& jobId, const uint32_t& delay) {
+    scheduled = delay;
+}
+
+int main() {
+    UnitTest button("Button Unit Test");
+
+    Host::setTime(1000);
+    Button pushButton(PIN);
+    pushButton.begin();
+    pushButton.onPress([]() { record("P"); });
+    pushButton.onRelease([]() { record("R"); });
+    pushButton.onLongPress([]() { record("L"); }, 700);
+
+    runAt(1000);
+    button.assertEqual("Button_IdleReportsNothing", "", takeEvents());
+    button.assertEqual("Button_IdleSchedulesNothing", UINT32_MAX, scheduled);
+
+    // The press bounces for 5 ms. It is reported once, and the button settles 20 ms after the first edge.
+    edgeAt(2000, LOW);
+    edgeAt(2001, HIGH);
+    edgeAt(2003, LOW);
+    edgeAt(2004, HIGH);
+    edgeAt(2005, LOW);
+    runAt(2006);
+    button.assertEqual("Button_BouncingPressIsReportedOnce", "P2006 ", takeEvents());
+    button.assertTrue("Button_BouncingPressIsPressed", pushButton.isPressed());
+    button.assertEqual("Button_BouncingPressSchedulesSettle", 14, scheduled);
+
+    runAt(2020);
+    button.assertEqual("Button_SettledPressReportsNothing", "", takeEvents());
+    button.assertEqual("Button_SettledPressSchedulesLongPress", 680, scheduled);
+
+    runAt(2700);
+    button.assertEqual("Button_LongPressIsReportedOnTime", "L2700 ", takeEvents());
+    button.assertTrue("Button_LongPressIsLongPressed", pushButton.isLongPressed());
+    button.assertEqual("Button_LongPressSchedulesNothing", UINT32_MAX, scheduled);
+
+    // The release bounces back to pressed before it ends released.
+    edgeAt(3000, HIGH);
+    edgeAt(3002, LOW);
+    edgeAt(3003, HIGH);
+    runAt(3004);
+    button.assertEqual("Button_BouncingReleaseIsReportedOnce", "R3004 ", takeEvents());
+    button.assertEqual("Button_BouncingReleaseSchedulesSettle", 16, scheduled);
+
+    runAt(3020);
+    button.assertEqual("Button_SettledReleaseReportsNothing", "", takeEvents());
+    button.assertFalse("Button_SettledReleaseIsReleased", pushButton.isPressed());
+
+    // The release comes within the bounce time, so its edge is ignored, and the level is read when the button settles.
+    edgeAt(4000, LOW);
+    edgeAt(4005, HIGH);
+    runAt(4006);
+    button.assertEqual("Button_IgnoredEdgeKeepsPress", "P4006 ", takeEvents());
+    runAt(4020);
+    button.assertEqual("Button_IgnoredEdgeIsReadAtSettle", "R4020 ", takeEvents());
+
+    // The interrupt of the final edge is missed, so only the level read at settle reports the release.
+    edgeAt(4500, LOW);
+    runAt(4501);
+    edgeAt(4510, HIGH, false);
+    runAt(4511);
+    button.assertEqual("Button_MissedEdgeKeepsPress", "P4501 ", takeEvents());
+    button.assertEqual("Button_MissedEdgeSchedulesSettle", 9, scheduled);
+    runAt(4520);
+    button.assertEqual("Button_MissedEdgeIsReadAtSettle", "R4520 ", takeEvents());
+    button.assertFalse("Button_MissedEdgeIsReleased", pushButton.isPressed());
+
+    // More edges than the ring holds come before the task runs, and the last one is missed.
+    for (uint8_t i = 0; i < 40; i++) {
+        edgeAt(5000, i % 2 ? HIGH : LOW);
+    }
+    edgeAt(5000, LOW, false);
+    runAt(5001);
+    runAt(5020);
+    button.assertTrue("Button_OverflowIsPressedAtSettle", pushButton.isPressed());
+    button.assertEqual("Button_OverflowReportsOnePress", "P5001 ", takeEvents());
+
+    edgeAt(6000, HIGH);
+    runAt(6030);
+    takeEvents();
+
+    // A continuous long press repeats every BUTTON_REPEAT_INTERVAL after its duration.
+    pushButton.onLongPress([]() { record("C"); }, 500, true);
+    edgeAt(7000, LOW);
+    runAt(7000);
+    runAt(7500);
+    runAt(7600);
+    runAt(7700);
+    button.assertEqual("Button_ContinuousLongPressRepeats", "P7000 C7500 C7600 C7700 ", takeEvents());
+    button.assertEqual("Button_ContinuousLongPressSchedulesRepeat", BUTTON_REPEAT_INTERVAL, scheduled);
+
+    edgeAt(8000, HIGH);
+    runAt(8000);
+    button.assertEqual("Button_ContinuousLongPressStopsAtRelease", "R8000 ", takeEvents());
+
+    button.attach(Host::console);
+    UnitTest::Result result = button.run();
+    return result.failed > 0;
+}
@@ -0,0 +1,160 @@
+#include <Host.h>
+#include <Adafruit/SSD1306/Adafruit_SSD1306.h>
+#include <UnitTest/UnitTest.h>
+
+#include <chrono>
+
+/**
+ * This test compares the drawChar of the SSD1306, which writes the columns of a glyph
+ * into the pages directly, with the pixel by pixel drawChar of Adafruit_GFX. Both draw
+ * every character of both code pages at every size, colour and clipping over the same
+ * pattern, and the buffers must be equal. It then prints how long a character takes.
+ */
+
+namespace {
+
+const int16_t SCREEN_WIDTH   = 128;
+const int16_t SCREEN_HEIGHT  = 64;
+const size_t BUFFER_SIZE    = SCREEN_WIDTH * SCREEN_HEIGHT / 8;
+
+/**
+ * @brief The SSD1306 drawing its characters with the drawChar of Adafruit_GFX.
+ *
+ */
+class Reference : public Adafruit_SSD1306 {
+   public:
+    Reference() : Adafruit_SSD1306(SCREEN_WIDTH, SCREEN_HEIGHT) {}
+
+    void drawChar(
+        int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size_x, uint8_t size_y
+    ) override {
+        Adafruit_GFX::drawChar(x, y, c, color, bg, size_x, size_y);
+    }
+};
+
+/**
+ * @brief Fill both displays with a background and stripes, so the pixels a glyph must not touch are checked too.
+ *
+ */
+void fillPattern(Adafruit_SSD1306& display, const uint16_t& background) {
+    display.fillScreen(background);
+    for (int16_t x = 0; x < SCREEN_WIDTH; x += 3) {
+        display.drawFastVLine(x, 0, SCREEN_HEIGHT, !background);
+    }
+}
+
+bool isSame(Adafruit_SSD1306& display, Adafruit_SSD1306& reference) {
+    return memcmp(display.getBuffer(), reference.getBuffer(), BUFFER_SIZE) == 0;
+}
+
+/**
+ * @brief Draw every character at every colour and position with a size on both displays.
+ *
+ * @return the first character that differs, or an empty string if none does.
+ */
+String compareSize(Adafruit_SSD1306& display, Reference& reference, const uint8_t& size) {
+    const uint16_t colors[][2] = {{1, 1}, {0, 0}, {1, 0}, {0, 1}, {2, 2}, {1, 2}, {0xFFFF, 0xFFFF}, {1, 0xFFFF}};
+    const int16_t xs[] = {-13, -7, -5, -1, 0, 5, 61, 117, 122, 124, 127, 128};
+    const int16_t ys[] = {-3, 0, 3, 12, 24, 44, 49, 50, 56, 60};
+
+    for (const auto& color : colors) {
+        for (const int16_t& y : ys) {
+            for (const int16_t& x : xs) {
+                for (uint16_t c = 0; c < 256; c++) {
+                    for (uint16_t background = 0; background < 2; background++) {
+                        fillPattern(display, background);
+                        fillPattern(reference, background);
+                        display.drawChar(x, y, c, color[0], color[1], size, size);
+                        reference.drawChar(x, y, c, color[0], color[1], size, size);
+                        if (!isSame(display, reference)) {
+                            return "c=" + String(c) + " x=" + String(x) + " y=" + String(y) +
+                                   " color=" + String(color[0]) + " bg=" + String(color[1]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return "";
+}
+
+/**
+ * @brief Measure how long a character takes to draw in white.
+ * The background is white for a transparent character and black for an opaque one.
+ *
+ * @return the time in nanoseconds per character.
+ */
+double measure(Adafruit_SSD1306& display, const uint8_t& size, const uint16_t& background) {
+    const uint16_t ROUNDS = 2000;
+    auto start = std::chrono::steady_clock::now();
+    for (uint16_t round = 0; round < ROUNDS; round++) {
+        for (uint8_t c = 32; c < 127; c++) {
+            display.drawChar((c * 6 * size) % 120, c % 2 ? 12 : 44 - 32 * (size - 1), c, 1, background, size, size);
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / (ROUNDS * 95);
+}
+
+};  // namespace
+
+int main() {
+    UnitTest drawChar("DrawChar Unit Test");
+
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT);
+    Reference reference;
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    reference.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+
+    for (uint8_t codePage = 0; codePage < 2; codePage++) {
+        display.cp437(codePage);
+        reference.cp437(codePage);
+        for (uint8_t size = 1; size <= 3; size++) {
+            String name = "DrawChar_" + String(codePage ? "Cp437" : "Classic") + "Size" + String(size) + "MatchesGFX";
+            drawChar.assertEqual(name, "", compareSize(display, reference, size));
+        }
+    }
+    display.cp437(false);
+    reference.cp437(false);
+
+    // print() reaches drawChar through write().
+    for (Adafruit_SSD1306* target : {(Adafruit_SSD1306*)&display, (Adafruit_SSD1306*)&reference}) {
+        target->fillScreen(0);
+        target->setTextColor(1);
+        target->setTextSize(2);
+        target->setCursor(0, 0);
+        target->print("1:23");
+        target->setTextSize(1);
+        target->setCursor(0, 24);
+        target->print("Al-Fatihah");
+        target->setCursor(0, 44);
+        target->print("Speaker ABC");
+    }
+    drawChar.assertTrue("DrawChar_PrintMatchesGFX", isSame(display, reference));
+
+    // A rotated display takes the pixel by pixel path.
+    display.setRotation(1);
+    reference.setRotation(1);
+    display.drawChar(3, 12, 'A', 1, 0, 1, 1);
+    reference.drawChar(3, 12, 'A', 1, 0, 1, 1);
+    drawChar.assertTrue("DrawChar_RotatedMatchesGFX", isSame(display, reference));
+    display.setRotation(0);
+    reference.setRotation(0);
+
+    drawChar.attach(Host::console);
+    UnitTest::Result result = drawChar.run();
+
+    for (uint8_t size = 1; size <= 2; size++) {
+        for (uint8_t isOpaque = 0; isOpaque < 2; isOpaque++) {
+            uint16_t background = isOpaque ? 0 : 1;
+            double fast         = measure(display, size, background);
+            double generic      = measure(reference, size, background);
+            Host::console.printf(
+                "drawChar size %u %s: %.1f ns, Adafruit_GFX %.1f ns, %.1fx\n", size,
+                isOpaque ? "opaque" : "transparent", fast, generic, generic / fast
+            );
+        }
+    }
+
+    return result.failed > 0;
+}
@@ -0,0 +1,193 @@
+#include <Host.h>
+#include <Adafruit/SSD1306/Adafruit_SSD1306.h>
+#include <UnitTest/UnitTest.h>
+
+#include <chrono>
+#include <random>
+
+/**
+ * This test compares the fillRect of the SSD1306, which fills whole pages of the
+ * buffer a row at a time, with the fillRect of Adafruit_GFX, which draws a vertical
+ * line per column. Both fill the same 800,000 random rectangles, clipped or not,
+ * in every rotation and colour over random buffers, and the buffers must be equal
+ * after each one. The lines are checked the same way against drawPixel. It then
+ * prints how long each primitive takes.
+ */
+
+namespace {
+
+const int16_t SCREEN_WIDTH        = 128;
+const int16_t SCREEN_HEIGHT       = 64;
+const size_t BUFFER_SIZE          = SCREEN_WIDTH * SCREEN_HEIGHT / 8;
+const uint32_t RECTS_PER_ROTATION = 200000;
+
+/**
+ * @brief The SSD1306 filling its rectangles with the fillRect of Adafruit_GFX.
+ *
+ */
+class Reference : public Adafruit_SSD1306 {
+   public:
+    Reference() : Adafruit_SSD1306(SCREEN_WIDTH, SCREEN_HEIGHT) {}
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override {
+        Adafruit_GFX::fillRect(x, y, w, h, color);
+    }
+};
+
+/**
+ * @brief Draw a line pixel by pixel.
+ *
+ * @param dx is 1 for a horizontal line.
+ * @param dy is 1 for a vertical line.
+ * @param length is the length of the line. Nothing is drawn if it is not positive.
+ */
+void drawPixels(
+    Adafruit_SSD1306& display, const int16_t& x, const int16_t& y, const int16_t& dx, const int16_t& dy,
+    const int16_t& length, const uint16_t& color
+) {
+    for (int16_t i = 0; i < length; i++) {
+        display.drawPixel(x + i * dx, y + i * dy, color);
+    }
+}
+
+bool isSame(Adafruit_SSD1306& display, Adafruit_SSD1306& reference) {
+    return memcmp(display.getBuffer(), reference.getBuffer(), BUFFER_SIZE) == 0;
+}
+
+/**
+ * @brief Draw the random rectangles and lines of a rotation on both displays.
+ *
+ * @return the first primitive that differs, or an empty string if none does.
+ */
+String compareRotation(Adafruit_SSD1306& display, Reference& reference, std::mt19937& random) {
+    auto between = [&](const int& low, const int& high) {
+        return std::uniform_int_distribution<int>(low, high)(random);
+    };
+
+    for (uint32_t i = 0; i < RECTS_PER_ROTATION; i++) {
+        if (i % 1000 == 0) {
+            for (size_t k = 0; k < BUFFER_SIZE; k++) {
+                display.getBuffer()[k] = reference.getBuffer()[k] = random();
+            }
+        }
+
+        int16_t x = between(-140, 140), y = between(-80, 80), w = between(-5, 150), h = between(-5, 90);
+        uint16_t color = i % 50 == 0 ? between(3, 0xFFFF) : between(0, 2);
+        if (i % 3 == 0) {
+            w = between(0, 12);
+            h = between(0, 12);
+        }
+
+        display.fillRect(x, y, w, h, color);
+        reference.fillRect(x, y, w, h, color);
+        if (!isSame(display, reference)) {
+            return "fillRect x=" + String(x) + " y=" + String(y) + " w=" + String(w) + " h=" + String(h) +
+                   " color=" + String(color);
+        }
+
+        if (i % 4 == 1) {
+            int16_t lineY = between(-3, 66);
+            display.drawFastHLine(x, lineY, w, color);
+            drawPixels(reference, x, lineY, 1, 0, w, color);
+            if (!isSame(display, reference)) {
+                return "drawFastHLine x=" + String(x) + " y=" + String(lineY) + " w=" + String(w) +
+                       " color=" + String(color);
+            }
+        } else if (i % 4 == 3) {
+            int16_t lineX = between(-3, 130);
+            display.drawFastVLine(lineX, y, h, color);
+            drawPixels(reference, lineX, y, 0, 1, h, color);
+            if (!isSame(display, reference)) {
+                return "drawFastVLine x=" + String(lineX) + " y=" + String(y) + " h=" + String(h) +
+                       " color=" + String(color);
+            }
+        }
+    }
+
+    display.fillScreen(reference.getRotation() & 1);
+    reference.fillScreen(reference.getRotation() & 1);
+    display.fillScreen(SSD1306_INVERSE);
+    reference.fillScreen(SSD1306_INVERSE);
+    return isSame(display, reference) ? "" : "fillScreen";
+}
+
+/**
+ * @brief Measure how long a primitive takes.
+ *
+ * @return the time in nanoseconds per call.
+ */
+template <class Draw>
+double measure(const uint32_t& rounds, Draw draw) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++) {
+        draw(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / rounds;
+}
+
+void report(const char* name, const double& fast, const double& reference) {
+    Host::console.printf("%-24s %8.1f ns, reference %8.1f ns, %5.1fx\n", name, fast, reference, reference / fast);
+}
+
+};  // namespace
+
+int main() {
+    UnitTest fillRect("FillRect Unit Test");
+
+    Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT);
+    Reference reference;
+    display.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+    reference.begin(SSD1306_SWITCHCAPVCC, 0x3C);
+
+    std::mt19937 random(1234);
+    for (uint8_t rotation = 0; rotation < 4; rotation++) {
+        display.setRotation(rotation);
+        reference.setRotation(rotation);
+        String name = "FillRect_Rotation" + String(rotation) + "MatchesGFX";
+        fillRect.assertEqual(name, "", compareRotation(display, reference, random));
+    }
+    display.setRotation(0);
+    reference.setRotation(0);
+
+    fillRect.attach(Host::console);
+    UnitTest::Result result = fillRect.run();
+
+    struct Case {
+        const char* name;
+        int16_t x, y, w, h;
+        uint16_t color;
+    } cases[] = {
+        {"fillScreen black", 0, 0, 128, 64, SSD1306_BLACK},
+        {"invert screen", 0, 0, 128, 64, SSD1306_INVERSE},
+        {"clear band y=44 h=8", 0, 44, 128, 8, SSD1306_BLACK},
+        {"clear band y=12 h=20", 0, 12, 128, 20, SSD1306_BLACK},
+        {"fill 10x10", 37, 21, 10, 10, SSD1306_WHITE},
+        {"invert 60x30", 33, 5, 60, 30, SSD1306_INVERSE},
+    };
+    for (const Case& c : cases) {
+        double fast = measure(20000, [&](const uint32_t& i) {
+            display.fillRect(c.x, c.y + (i & 1), c.w, c.h, c.color);
+        });
+        double slow = measure(20000, [&](const uint32_t& i) {
+            reference.fillRect(c.x, c.y + (i & 1), c.w, c.h, c.color);
+        });
+        report(c.name, fast, slow);
+    }
+
+    double fast = measure(200000, [&](const uint32_t& i) {
+        display.drawFastHLine(i & 7, 20 + (i & 15), 120, SSD1306_INVERSE);
+    });
+    double slow = measure(200000, [&](const uint32_t& i) {
+        drawPixels(reference, i & 7, 20 + (i & 15), 1, 0, 120, SSD1306_INVERSE);
+    });
+    report("invert hline w=120", fast, slow);
+
+    fast = measure(200000, [&](const uint32_t& i) { display.drawFastVLine(20 + (i & 63), i & 7, 50, SSD1306_WHITE); });
+    slow = measure(200000, [&](const uint32_t& i) {
+        drawPixels(reference, 20 + (i & 63), i & 7, 0, 1, 50, SSD1306_WHITE);
+    });
+    report("fill vline h=50", fast, slow);
+
+    return result.failed > 0;
+}
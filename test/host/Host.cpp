@@ -0,0 +1,808 @@
+#include "Host.h"
+
+#include <SPI.h>
+#include <SPIFFS.h>
+#include <WiFi.h>
+#include <Wire.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+
+HardwareSerial Serial;
+HardwareSerial Serial1;
+HardwareSerial Serial2;
+EspClass ESP;
+TwoWire Wire;
+WiFiClass WiFi;
+SPIClass SPI;
+SPIFFSFS SPIFFS;
+
+namespace Host {
+
+Console console;
+
+namespace {
+
+const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::now();
+
+std::atomic<bool> isManualTime(false);
+std::atomic<uint64_t> manualMicros(0);
+
+struct Pin {
+    uint8_t level           = HIGH;
+    void (*handler)(void*)  = NULL;
+    void* argument          = NULL;
+};
+
+std::mutex pinMutex;
+std::map<uint8_t, Pin> pins;
+
+std::mt19937 generator(1);
+
+std::atomic<bool> isWiFiConnected(false);
+
+/**
+ * @brief A TCP connection between two ends in the program. Each end reads one
+ * queue and writes the other, and closing either end closes both.
+ *
+ */
+struct Connection {
+    std::mutex mutex;
+    std::deque<uint8_t> queues[2];
+    uint16_t port       = 0;
+    uint16_t clientPort = 0;
+    bool isClosed       = false;
+};
+
+/**
+ * @brief The servers listening on the ports of the host, with the connections
+ * they have not accepted yet.
+ *
+ */
+struct Network {
+    std::mutex mutex;
+    std::map<uint16_t, std::deque<WiFiClient>> listeners;
+    uint16_t nextClientPort = 49152;
+};
+
+/**
+ * @brief Get the network. It is never destroyed, as the servers of a test
+ * may only be stopped by the destructors that run at exit.
+ *
+ */
+Network& getNetwork() {
+    static Network* network = new Network();
+    return *network;
+}
+
+/**
+ * @brief A FreeRTOS task. Its notification value is a counter guarded by the mutex.
+ * A task deleted by another one is only marked, and its thread ends at its next wait.
+ *
+ */
+struct Task {
+    std::mutex mutex;
+    std::condition_variable condition;
+    uint32_t notifications = 0;
+    bool isDeleted         = false;
+    bool isEnded           = false;
+};
+
+/**
+ * @brief Thrown in a task that is deleted, to end its thread.
+ *
+ */
+struct TaskDeleted {};
+
+Task mainTask;
+thread_local Task* currentTask = &mainTask;
+
+/**
+ * @brief A semaphore, a mutex or a recursive mutex. It is given under its mutex,
+ * so the task that takes it can delete it right away, as FreeRTOS allows.
+ * A mutex is a binary semaphore that starts given. A recursive mutex also counts
+ * how many times its owner has taken it.
+ *
+ */
+struct Semaphore {
+    std::mutex mutex;
+    std::condition_variable condition;
+    uint32_t count   = 0;
+    bool isRecursive = false;
+    Task* owner      = NULL;
+    uint32_t depth   = 0;
+};
+
+/**
+ * @brief Wait on a condition for a number of ticks, or forever with portMAX_DELAY.
+ *
+ * @return true if the predicate is true.
+ */
+template <class Predicate>
+bool wait(
+    std::condition_variable& condition, std::unique_lock<std::mutex>& lock, const TickType_t& ticks,
+    Predicate predicate
+) {
+    if (ticks == portMAX_DELAY) {
+        condition.wait(lock, predicate);
+        return true;
+    }
+    return condition.wait_for(lock, std::chrono::milliseconds(ticks), predicate);
+}
+
+};  // namespace
+
+/**
+ * @brief Stop the clock at a time. It only moves with advanceTime() afterwards.
+ *
+ * @param millis is the time in milliseconds.
+ */
+void setTime(const uint32_t& millis) {
+    manualMicros = (uint64_t)millis * 1000;
+    isManualTime = true;
+}
+
+/**
+ * @brief Move the stopped clock forward.
+ *
+ * @param millis is the time to add in milliseconds.
+ */
+void advanceTime(const uint32_t& millis) {
+    manualMicros += (uint64_t)millis * 1000;
+}
+
+/**
+ * @brief Let the clock follow the real time again.
+ *
+ */
+void useRealTime() {
+    isManualTime = false;
+}
+
+/**
+ * @brief Set the level of an input pin, as if it was driven from outside.
+ *
+ * @param pin is the pin.
+ * @param level is the level, HIGH or LOW.
+ * @param isInterrupted is false to miss the edge, so no interrupt runs even if the level changed.
+ */
+void setPin(const uint8_t& pin, const uint8_t& level, const bool& isInterrupted) {
+    bool isChanged;
+    {
+        std::lock_guard<std::mutex> lock(pinMutex);
+        isChanged       = pins[pin].level != level;
+        pins[pin].level = level;
+    }
+
+    if (isChanged && isInterrupted) {
+        interrupt(pin);
+    }
+}
+
+/**
+ * @brief Run the interrupt handler of a pin, whether its level changed or not.
+ * Interrupts run on the calling thread.
+ *
+ * @param pin is the pin.
+ */
+void interrupt(const uint8_t& pin) {
+    void (*handler)(void*);
+    void* argument;
+    {
+        std::lock_guard<std::mutex> lock(pinMutex);
+        handler  = pins[pin].handler;
+        argument = pins[pin].argument;
+    }
+
+    if (handler) {
+        handler(argument);
+    }
+}
+
+/**
+ * @brief Connect the host to a WiFi network or disconnect it.
+ * TCP clients only connect while it is connected.
+ *
+ * @param isConnected is true to connect.
+ */
+void setConnected(const bool& isConnected) {
+    isWiFiConnected = isConnected;
+}
+
+/**
+ * @brief One end of a connection. The client is end 0 and the server is end 1.
+ *
+ */
+struct Socket {
+    std::shared_ptr<Connection> connection;
+    uint8_t end;
+
+    std::deque<uint8_t>& input() { return connection->queues[end]; }
+    std::deque<uint8_t>& output() { return connection->queues[1 - end]; }
+};
+
+size_t Console::write(uint8_t value) {
+    return fwrite(&value, 1, 1, stdout);
+}
+
+size_t Console::write(const uint8_t* buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
+
+};  // namespace Host
+
+using namespace Host;
+
+/*----- Arduino -----*/
+
+unsigned long millis() {
+    return micros() / 1000;
+}
+
+unsigned long micros() {
+    if (isManualTime) {
+        return manualMicros;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - START).count();
+}
+
+/**
+ * @brief Wait for a number of milliseconds. On the stopped clock, the main task moves it
+ * forward. The other tasks always wait in real time, so they still poll while the test steps
+ * the clock, and they end here once they are deleted.
+ *
+ */
+void delay(uint32_t ms) {
+    Task* task = currentTask;
+    if (task == &mainTask) {
+        if (isManualTime) {
+            advanceTime(ms);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        }
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(task->mutex);
+    if (wait(task->condition, lock, ms, [task]() { return task->isDeleted; })) {
+        throw TaskDeleted();
+    }
+}
+
+void delayMicroseconds(uint32_t us) {
+    if (!isManualTime) {
+        std::this_thread::sleep_for(std::chrono::microseconds(us));
+    }
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+long random(long max) {
+    return max > 0 ? std::uniform_int_distribution<long>(0, max - 1)(generator) : 0;
+}
+
+long random(long min, long max) {
+    return min < max ? min + random(max - min) : min;
+}
+
+long map(long value, long fromLow, long fromHigh, long toLow, long toHigh) {
+    return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+uint32_t esp_random() {
+    return generator();
+}
+
+void esp_efuse_mac_get_default(uint8_t* mac) {
+    const uint8_t address[6] = {0x24, 0x0A, 0xC4, 0x00, 0x00, 0x01};
+    memcpy(mac, address, sizeof(address));
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    std::lock_guard<std::mutex> lock(pinMutex);
+    if (mode == INPUT_PULLUP) {
+        pins[pin].level = HIGH;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    std::lock_guard<std::mutex> lock(pinMutex);
+    return pins[pin].level;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    std::lock_guard<std::mutex> lock(pinMutex);
+    pins[pin].level = value;
+}
+
+int digitalPinToInterrupt(int pin) {
+    return pin;
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* argument, int mode) {
+    std::lock_guard<std::mutex> lock(pinMutex);
+    pins[pin].handler  = handler;
+    pins[pin].argument = argument;
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode) {
+    attachInterruptArg(pin, (void (*)(void*))handler, NULL, mode);
+}
+
+void detachInterrupt(uint8_t pin) {
+    std::lock_guard<std::mutex> lock(pinMutex);
+    pins[pin].handler  = NULL;
+    pins[pin].argument = NULL;
+}
+
+uint16_t htons(uint16_t value) {
+    return __builtin_bswap16(value);
+}
+
+uint16_t ntohs(uint16_t value) {
+    return __builtin_bswap16(value);
+}
+
+uint32_t htonl(uint32_t value) {
+    return __builtin_bswap32(value);
+}
+
+uint32_t ntohl(uint32_t value) {
+    return __builtin_bswap32(value);
+}
+
+size_t HardwareSerial::write(uint8_t value) {
+    return console.write(value);
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    return console.write(buffer, size);
+}
+
+/*----- Wire -----*/
+
+TwoWire::TwoWire(uint8_t bus)
+    : m_Clock(100000), m_Address(0), m_TransmissionSize(0), m_ReceivedSize(0), m_ReadIndex(0) {}
+
+void TwoWire::attach(const uint8_t& address, I2CDevice* device) {
+    std::lock_guard<std::recursive_mutex> lock(m_Lock);
+    m_Devices[address] = device;
+}
+
+void TwoWire::detach(const uint8_t& address) {
+    std::lock_guard<std::recursive_mutex> lock(m_Lock);
+    m_Devices.erase(address);
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) {
+    if (frequency) {
+        setClock(frequency);
+    }
+    return true;
+}
+
+bool TwoWire::setClock(uint32_t frequency) {
+    std::lock_guard<std::recursive_mutex> lock(m_Lock);
+    m_Clock = frequency;
+    return true;
+}
+
+uint32_t TwoWire::getClock() {
+    std::lock_guard<std::recursive_mutex> lock(m_Lock);
+    return m_Clock;
+}
+
+/**
+ * @brief Start a transmission. It holds the bus until endTransmission(), like the HAL lock of the driver.
+ *
+ */
+void TwoWire::beginTransmission(uint16_t address) {
+    m_Lock.lock();
+    m_Address          = address;
+    m_TransmissionSize = 0;
+}
+
+/**
+ * @brief Send the transmission to the device at its address and let the bus go.
+ *
+ * @return 0 on success, 2 if no device answers at the address.
+ */
+uint8_t TwoWire::endTransmission(bool sendStop) {
+    auto device    = m_Devices.find(m_Address);
+    uint8_t result = 2;
+    if (device != m_Devices.end()) {
+        device->second->receive(m_Transmission, m_TransmissionSize, m_Clock);
+        result = 0;
+    }
+    m_TransmissionSize = 0;
+    m_Lock.unlock();
+    return result;
+}
+
+size_t TwoWire::requestFrom(uint16_t address, size_t size, bool sendStop) {
+    std::lock_guard<std::recursive_mutex> lock(m_Lock);
+    size           = min(size, (size_t)I2C_BUFFER_LENGTH);
+    m_ReceivedSize = 0;
+    m_ReadIndex    = 0;
+
+    auto device = m_Devices.find(address);
+    if (device != m_Devices.end()) {
+        m_ReceivedSize = device->second->transmit(m_Received, size, m_Clock);
+    }
+    return m_ReceivedSize;
+}
+
+/**
+ * @brief Add a byte to the transmission. Like the driver, it fails once the buffer is full.
+ *
+ */
+size_t TwoWire::write(uint8_t value) {
+    if (m_TransmissionSize >= I2C_BUFFER_LENGTH) {
+        return 0;
+    }
+    m_Transmission[m_TransmissionSize++] = value;
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (written < size && write(buffer[written])) {
+        written++;
+    }
+    return written;
+}
+
+int TwoWire::available() {
+    return m_ReceivedSize - m_ReadIndex;
+}
+
+int TwoWire::read() {
+    return m_ReadIndex < m_ReceivedSize ? m_Received[m_ReadIndex++] : -1;
+}
+
+int TwoWire::peek() {
+    return m_ReadIndex < m_ReceivedSize ? m_Received[m_ReadIndex] : -1;
+}
+
+/*----- WiFi -----*/
+
+bool WiFiClass::isConnected() {
+    return isWiFiConnected;
+}
+
+/**
+ * @brief Connect to a server of the program. Every host name is the host itself.
+ *
+ * @return 1 if a server listens on the port, 0 otherwise.
+ */
+int WiFiClient::connect(const char* host, uint16_t port) {
+    stop();
+
+    Network& network = getNetwork();
+    std::lock_guard<std::mutex> lock(network.mutex);
+    auto listener = network.listeners.find(port);
+    if (listener == network.listeners.end()) {
+        return 0;
+    }
+
+    std::shared_ptr<Connection> connection = std::make_shared<Connection>();
+    connection->port       = port;
+    connection->clientPort = network.nextClientPort++;
+
+    WiFiClient accepted;
+    accepted.m_Socket.reset(new Socket{connection, 1});
+    listener->second.push_back(accepted);
+
+    m_Socket.reset(new Socket{connection, 0});
+    return 1;
+}
+
+size_t WiFiClient::write(const uint8_t* buffer, size_t size) {
+    if (!m_Socket) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Socket->connection->mutex);
+    if (m_Socket->connection->isClosed) {
+        return 0;
+    }
+    m_Socket->output().insert(m_Socket->output().end(), buffer, buffer + size);
+    return size;
+}
+
+int WiFiClient::read(uint8_t* buffer, size_t size) {
+    if (!m_Socket) {
+        return -1;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Socket->connection->mutex);
+    std::deque<uint8_t>& input = m_Socket->input();
+    if (input.empty()) {
+        return -1;
+    }
+
+    size = min(size, input.size());
+    std::copy(input.begin(), input.begin() + size, buffer);
+    input.erase(input.begin(), input.begin() + size);
+    return size;
+}
+
+int WiFiClient::available() {
+    if (!m_Socket) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Socket->connection->mutex);
+    return m_Socket->input().size();
+}
+
+/**
+ * @brief Check the connection. Like lwIP, a closed connection stays connected
+ * until what it received is read.
+ *
+ */
+uint8_t WiFiClient::connected() {
+    if (!m_Socket) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(m_Socket->connection->mutex);
+    return !m_Socket->connection->isClosed || !m_Socket->input().empty();
+}
+
+IPAddress WiFiClient::remoteIP() {
+    return m_Socket ? IPAddress(127, 0, 0, 1) : IPAddress();
+}
+
+uint16_t WiFiClient::remotePort() {
+    if (!m_Socket) {
+        return 0;
+    }
+    return m_Socket->end == 0 ? m_Socket->connection->port : m_Socket->connection->clientPort;
+}
+
+void WiFiClient::stop() {
+    if (!m_Socket) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Socket->connection->mutex);
+        m_Socket->connection->isClosed = true;
+        m_Socket->input().clear();
+    }
+    m_Socket.reset();
+}
+
+void WiFiServer::begin() {
+    Network& network = getNetwork();
+    std::lock_guard<std::mutex> lock(network.mutex);
+    network.listeners[m_Port];
+}
+
+/**
+ * @brief Accept a pending connection. A connection is only handed over once the
+ * client sent its first bytes, so the server never reads an empty request.
+ *
+ * @return the connection, or a client that is not connected if there is none.
+ */
+WiFiClient WiFiServer::available() {
+    Network& network = getNetwork();
+    std::lock_guard<std::mutex> lock(network.mutex);
+    auto listener = network.listeners.find(m_Port);
+    if (listener == network.listeners.end()) {
+        return WiFiClient();
+    }
+
+    std::deque<WiFiClient>& pending = listener->second;
+    for (auto client = pending.begin(); client != pending.end(); client++) {
+        if (client->available() || !client->connected()) {
+            WiFiClient accepted = *client;
+            pending.erase(client);
+            return accepted;
+        }
+    }
+    return WiFiClient();
+}
+
+void WiFiServer::stop() {
+    std::deque<WiFiClient> pending;
+    {
+        Network& network = getNetwork();
+        std::lock_guard<std::mutex> lock(network.mutex);
+        auto listener = network.listeners.find(m_Port);
+        if (listener == network.listeners.end()) {
+            return;
+        }
+        pending.swap(listener->second);
+        network.listeners.erase(listener);
+    }
+
+    for (WiFiClient& client : pending) {
+        client.stop();
+    }
+}
+
+/*----- FreeRTOS -----*/
+
+BaseType_t xTaskCreate(
+    TaskFunction_t function, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority,
+    TaskHandle_t* task
+) {
+    Task* created = new Task();
+    if (task) {
+        *task = created;
+    }
+
+    std::thread([created, function, parameter]() {
+        currentTask = created;
+        try {
+            function(parameter);
+        } catch (const TaskDeleted&) {
+        }
+
+        std::lock_guard<std::mutex> lock(created->mutex);
+        created->isEnded = true;
+        created->condition.notify_all();
+    }).detach();
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(
+    TaskFunction_t function, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority,
+    TaskHandle_t* task, BaseType_t core
+) {
+    return xTaskCreate(function, name, stackSize, parameter, priority, task);
+}
+
+/**
+ * @brief Delete a task. A thread cannot be stopped from outside, so another task is
+ * marked and this waits until its thread ends at its next delay or notification wait,
+ * as nothing of it may run once it is deleted.
+ *
+ */
+void vTaskDelete(TaskHandle_t task) {
+    if (task == NULL || task == currentTask) {
+        throw TaskDeleted();
+    }
+
+    Task* target = (Task*)task;
+    std::unique_lock<std::mutex> lock(target->mutex);
+    target->isDeleted = true;
+    target->condition.notify_all();
+    target->condition.wait(lock, [target]() { return target->isEnded; });
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks);
+}
+
+void taskYIELD() {
+    std::this_thread::yield();
+}
+
+TickType_t xTaskGetTickCount() {
+    return millis();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+    return currentTask;
+}
+
+uint8_t* pxTaskGetStackStart(TaskHandle_t task) {
+    return NULL;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    Task* target = (Task*)task;
+    std::lock_guard<std::mutex> lock(target->mutex);
+    target->notifications++;
+    target->condition.notify_all();
+    return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* isWoken) {
+    xTaskNotifyGive(task);
+    if (isWoken) {
+        *isWoken = pdFALSE;
+    }
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t isCleared, TickType_t ticks) {
+    Task* task = currentTask;
+    std::unique_lock<std::mutex> lock(task->mutex);
+    wait(task->condition, lock, ticks, [task]() { return task->notifications > 0 || task->isDeleted; });
+    if (task->isDeleted) {
+        throw TaskDeleted();
+    }
+
+    uint32_t notifications = task->notifications;
+    if (isCleared) {
+        task->notifications = 0;
+    } else if (notifications > 0) {
+        task->notifications--;
+    }
+    return notifications;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary() {
+    return new Semaphore();
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex() {
+    Semaphore* semaphore = new Semaphore();
+    semaphore->count     = 1;
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() {
+    Semaphore* semaphore   = new Semaphore();
+    semaphore->isRecursive = true;
+    return semaphore;
+}
+
+void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+    delete (Semaphore*)semaphore;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t handle, TickType_t ticks) {
+    Semaphore* semaphore = (Semaphore*)handle;
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    if (!wait(semaphore->condition, lock, ticks, [semaphore]() { return semaphore->count > 0; })) {
+        return pdFALSE;
+    }
+    semaphore->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t handle) {
+    Semaphore* semaphore = (Semaphore*)handle;
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    if (semaphore->count > 0) {
+        return pdFALSE;
+    }
+    semaphore->count = 1;
+    semaphore->condition.notify_all();
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t handle, TickType_t ticks) {
+    Semaphore* semaphore = (Semaphore*)handle;
+    Task* task           = currentTask;
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+    auto isFree = [semaphore, task]() { return semaphore->owner == NULL || semaphore->owner == task; };
+    if (!wait(semaphore->condition, lock, ticks, isFree)) {
+        return pdFALSE;
+    }
+    semaphore->owner = task;
+    semaphore->depth++;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t handle) {
+    Semaphore* semaphore = (Semaphore*)handle;
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    if (semaphore->owner != currentTask) {
+        return pdFALSE;
+    }
+    if (--semaphore->depth > 0) {
+        return pdTRUE;
+    }
+    semaphore->owner = NULL;
+    semaphore->condition.notify_all();
+    return pdTRUE;
+}
+
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t handle) {
+    Semaphore* semaphore = (Semaphore*)handle;
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    return semaphore->isRecursive ? semaphore->owner == NULL : semaphore->count;
+}
@@ -0,0 +1,39 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Host controls the stand-ins of the Arduino core and FreeRTOS
+ * that the host tests run the sources against.
+ *
+ * The clock is real unless a test sets it, so tests that drive the
+ * sources step by step get exact timestamps, and tests with tasks can
+ * still wait on each other.
+ */
+namespace Host {
+
+void setTime(const uint32_t& millis);
+void advanceTime(const uint32_t& millis);
+void useRealTime();
+
+void setConnected(const bool& isConnected);
+
+void setPin(const uint8_t& pin, const uint8_t& level, const bool& isInterrupted = true);
+void interrupt(const uint8_t& pin);
+
+/**
+ * @brief A printer to the standard output, to attach the unit tests to.
+ *
+ */
+class Console : public Print {
+   public:
+    size_t write(uint8_t value) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+};
+
+extern Console console;
+
+};  // namespace Host
+
+#endif
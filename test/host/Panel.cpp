@@ -0,0 +1,165 @@
+#include "Panel.h"
+
+namespace Host {
+
+namespace {
+
+/**
+ * @brief Get the number of arguments that follow a command of the SSD1306.
+ *
+ */
+uint8_t getArgumentCount(const uint8_t& command) {
+    switch (command) {
+        case 0x20:  // Memory addressing mode
+        case 0x81:  // Contrast
+        case 0x8D:  // Charge pump
+        case 0xA8:  // Multiplex ratio
+        case 0xD3:  // Display offset
+        case 0xD5:  // Clock divide
+        case 0xD9:  // Precharge period
+        case 0xDA:  // COM pins
+        case 0xDB:  // VCOMH deselect level
+            return 1;
+        case 0x21:  // Column address
+        case 0x22:  // Page address
+        case 0xA3:  // Vertical scroll area
+            return 2;
+        case 0x29:  // Vertical and right horizontal scroll
+        case 0x2A:  // Vertical and left horizontal scroll
+            return 5;
+        case 0x26:  // Right horizontal scroll
+        case 0x27:  // Left horizontal scroll
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+};  // namespace
+
+/**
+ * @brief Create a panel with a blank RAM.
+ *
+ * @param width is the number of columns.
+ * @param height is the number of rows, a multiple of 8.
+ */
+Panel::Panel(const uint8_t& width, const uint8_t& height)
+    : m_RAM(width * (height / 8), 0),
+      m_Width(width),
+      m_Pages(height / 8),
+      m_ColumnEnd(width - 1),
+      m_PageEnd(height / 8 - 1) {}
+
+/**
+ * @brief Take a transmission. Its first byte tells whether commands or data follow.
+ * A command may continue in the next transmission, as the driver splits long lists.
+ *
+ */
+void Panel::receive(const uint8_t* data, const size_t& size, const uint32_t& clock) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Bytes += size;
+    m_Transmissions++;
+    if (size == 0) {
+        return;
+    }
+
+    bool isData = data[0] & 0x40;
+    for (size_t i = 1; i < size; i++) {
+        if (isData) {
+            _data(data[i]);
+        } else {
+            _command(data[i]);
+        }
+    }
+}
+
+bool Panel::getPixel(const uint8_t& x, const uint8_t& y) {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_RAM[(y / 8) * m_Width + x] & (1 << (y & 7));
+}
+
+/**
+ * @brief Get a copy of the RAM, laid out like the buffer of the driver.
+ *
+ */
+std::vector<uint8_t> Panel::getRAM() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_RAM;
+}
+
+/**
+ * @brief Get the number of bytes received since the panel was created,
+ * with the control bytes but without the addresses.
+ *
+ */
+uint32_t Panel::getBytes() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Bytes;
+}
+
+uint32_t Panel::getTransmissions() {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Transmissions;
+}
+
+/**
+ * @brief Print the RAM as a plain PBM image, in the format of Adafruit_SSD1306::printPBM().
+ *
+ */
+void Panel::printPBM(Print& out) {
+    uint8_t height = m_Pages * 8;
+    out.print("P1\n");
+    out.print(m_Width);
+    out.print(' ');
+    out.println(height);
+    for (uint8_t y = 0; y < height; y++) {
+        for (uint8_t x = 0; x < m_Width; x++) {
+            out.print(getPixel(x, y) ? '1' : '0');
+            if ((x & 63) == 63 || x == m_Width - 1) {
+                out.println();
+            }
+        }
+    }
+}
+
+void Panel::_command(const uint8_t& value) {
+    if (m_ArgumentsNeeded == 0) {
+        m_Command         = value;
+        m_ArgumentCount   = 0;
+        m_ArgumentsNeeded = getArgumentCount(value);
+        return;
+    }
+
+    m_Arguments[m_ArgumentCount++] = value;
+    if (--m_ArgumentsNeeded > 0) {
+        return;
+    }
+
+    if (m_Command == 0x21) {
+        m_ColumnStart = min(m_Arguments[0], (uint8_t)(m_Width - 1));
+        m_ColumnEnd   = min(m_Arguments[1], (uint8_t)(m_Width - 1));
+        m_Column      = m_ColumnStart;
+    } else if (m_Command == 0x22) {
+        m_PageStart = min(m_Arguments[0], (uint8_t)(m_Pages - 1));
+        m_PageEnd   = min(m_Arguments[1], (uint8_t)(m_Pages - 1));
+        m_Page      = m_PageStart;
+    }
+}
+
+/**
+ * @brief Write a byte at the address, which then moves right and wraps
+ * to the next page of the window, then to its first page.
+ *
+ */
+void Panel::_data(const uint8_t& value) {
+    m_RAM[m_Page * m_Width + m_Column] = value;
+    if (m_Column < m_ColumnEnd) {
+        m_Column++;
+        return;
+    }
+
+    m_Column = m_ColumnStart;
+    m_Page   = m_Page < m_PageEnd ? m_Page + 1 : m_PageStart;
+}
+
+};  // namespace Host
@@ -0,0 +1,54 @@
+#ifndef HOST_PANEL_H
+#define HOST_PANEL_H
+
+#include <Wire.h>
+
+#include <mutex>
+#include <vector>
+
+namespace Host {
+
+/**
+ * @brief An SSD1306 on the I2C bus. It keeps its RAM in step with the commands
+ * and the data it receives in horizontal addressing mode, the mode the driver
+ * sets, and counts the bytes, so a test can check what reached the screen and
+ * how much of the bus it took.
+ *
+ */
+class Panel : public I2CDevice {
+   public:
+    Panel(const uint8_t& width = 128, const uint8_t& height = 64);
+
+    void receive(const uint8_t* data, const size_t& size, const uint32_t& clock) override;
+
+    bool getPixel(const uint8_t& x, const uint8_t& y);
+    std::vector<uint8_t> getRAM();
+    uint32_t getBytes();
+    uint32_t getTransmissions();
+    void printPBM(Print& out);
+
+   private:
+    std::mutex m_Mutex;
+    std::vector<uint8_t> m_RAM;
+    uint8_t m_Width;
+    uint8_t m_Pages;
+    uint8_t m_ColumnStart = 0;
+    uint8_t m_ColumnEnd;
+    uint8_t m_PageStart = 0;
+    uint8_t m_PageEnd;
+    uint8_t m_Column    = 0;
+    uint8_t m_Page      = 0;
+    uint8_t m_Command   = 0;
+    uint8_t m_Arguments[6];
+    uint8_t m_ArgumentCount   = 0;
+    uint8_t m_ArgumentsNeeded = 0;
+    uint32_t m_Bytes          = 0;
+    uint32_t m_Transmissions  = 0;
+
+    void _command(const uint8_t& value);
+    void _data(const uint8_t& value);
+};
+
+};  // namespace Host
+
+#endif
@@ -0,0 +1,224 @@
+#include <Host.h>
+#include <Panel.h>
+#include <UnitTest/UnitTest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "Config.h"
+#include "Display.h"
+
+/**
+ * This test renders the screens of Display.h on an SSD1306 stand-in on the I2C bus,
+ * with a fixed time and schedule, and with clients that joined the RTTP server over
+ * the loopback network of the host. Each screen is compared with its PBM image in
+ * golden, and the RAM of the panel with the buffer of the driver. The frames are sent
+ * in the background, as on the board.
+ *
+ * It then scrolls both lines of the schedule screen and prints how long a frame takes
+ * to draw and send, how many bytes it puts on the bus, and the bus usage at the scroll
+ * interval of the firmware.
+ *
+ * Run it with UPDATE_GOLDEN=1 to write the images again after a change of the screens.
+ */
+
+namespace {
+
+const uint32_t TIMESTAMP         = 1767254400;  // Thursday 1 January 2026, 15:00 in UTC+7
+const uint32_t SCROLL_INTERVAL   = 50;
+const uint16_t SCROLL_FRAMES     = 2000;
+const uint32_t JOIN_TIMEOUT      = 5000;
+const uint8_t DISPLAY_ADDRESS    = 0x3C;
+const char* const CLIENT_NAMES[] = {"Ali", "Budi", "Citra", "Dewi"};
+const uint8_t CLIENT_COUNT       = sizeof(CLIENT_NAMES) / sizeof(CLIENT_NAMES[0]);
+
+Host::Panel panel;
+
+/**
+ * @brief A printer into a string, to hold an image.
+ *
+ */
+class Image : public Print {
+   public:
+    std::string text;
+
+    size_t write(uint8_t value) override {
+        text += (char)value;
+        return 1;
+    }
+};
+
+/**
+ * @brief Compare what the panel shows with an image in golden, or write the image.
+ *
+ * @return an empty string if they are equal, what differs otherwise.
+ */
+String compareGolden(const String& name) {
+    Image image;
+    panel.printPBM(image);
+
+    std::string path = std::string(GOLDEN_DIR) + "/" + name.c_str() + ".pbm";
+    if (getenv("UPDATE_GOLDEN")) {
+        std::ofstream(path) << image.text;
+    }
+
+    std::ifstream file(path);
+    if (!file) {
+        return "no image at " + String(path.c_str());
+    }
+
+    std::stringstream golden;
+    golden << file.rdbuf();
+    return golden.str() == image.text ? "" : "the screen differs from " + String(path.c_str());
+}
+
+/**
+ * @brief Check that the panel shows the buffer of the driver. It reads the buffer
+ * pixel by pixel, since getBuffer() would make the next frame send everything.
+ *
+ */
+bool isShowingBuffer() {
+    for (uint8_t y = 0; y < g_OLED.height(); y++) {
+        for (uint8_t x = 0; x < g_OLED.width(); x++) {
+            if (panel.getPixel(x, y) != g_OLED.getPixel(x, y)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Show a screen and check it. It prints the bytes the screen put on the bus.
+ *
+ * @param test is the unit test to add the assertions to.
+ * @param name is the name of the screen and of its image.
+ * @param show draws the screen and displays it.
+ */
+template <class Show>
+void checkScreen(UnitTest& test, const String& name, Show show) {
+    uint32_t bytes         = panel.getBytes();
+    uint32_t transmissions = panel.getTransmissions();
+    show();
+    g_OLED.waitForTransfer();
+    bytes         = panel.getBytes() - bytes;
+    transmissions = panel.getTransmissions() - transmissions;
+
+    test.assertTrue("Screen_" + name + "_PanelShowsBuffer", isShowingBuffer());
+    test.assertEqual("Screen_" + name + "_MatchesGolden", "", compareGolden(name));
+    Host::console.printf("%-12s %5u bytes in %3u transmissions\n", name.c_str(), bytes, transmissions);
+}
+
+/**
+ * @brief Join the clients to the channel of the firmware and wait until the server knows their names.
+ *
+ * @return true if every client joined in time.
+ */
+bool joinClients(std::vector<std::unique_ptr<RTTP::Client>>& clients, std::atomic<uint8_t>& joined) {
+    for (uint8_t i = 0; i < CLIENT_COUNT; i++) {
+        clients.emplace_back(new RTTP::Client("127.0.0.1", 80, CLIENT_NAMES[i], "client-" + String(i)));
+        clients.back()->onAuth([&joined](const bool& success) {
+            if (success) {
+                joined++;
+            }
+        });
+        clients.back()->join(RTTP_CHANNEL, DEVICE_PASS);
+    }
+
+    uint32_t start = millis();
+    while (joined < CLIENT_COUNT && millis() - start < JOIN_TIMEOUT) {
+        delay(1);
+    }
+    return joined == CLIENT_COUNT;
+}
+
+void setSchedule() {
+    g_Location.getSetting(Config::LATITUDE).value  = -7.797;
+    g_Location.getSetting(Config::LONGITUDE).value = 110.371;
+    g_Location.getSetting(Config::ELEVATION).value = 113;
+
+    g_PrayerOngoing = Prayer(Prayer::Asr, 15 * 3600 + 12 * 60, 2);
+    g_QiroOngoing   = Qiro(Prayer::Asr, 10, {Surah(36, 20), Surah(67, 20), Surah(78, 20)});
+    g_SurahOngoing  = SurahAudio(36, 20, false, true);
+}
+
+};  // namespace
+
+int main() {
+    UnitTest screen("Screen Unit Test");
+
+    Config::initialize();
+    g_Device.version = "1.0.0";
+    setSchedule();
+
+    Wire.attach(DISPLAY_ADDRESS, &panel);
+    g_OLED.begin(SSD1306_SWITCHCAPVCC, DISPLAY_ADDRESS);
+    g_OLED.beginAsync();
+
+    Host::setConnected(true);
+    g_Server.createChannel(RTTP_CHANNEL).onAuth([](const RTTP::Auth& auth) { return auth.secret == DEVICE_PASS; });
+    g_Server.begin();
+
+    std::vector<std::unique_ptr<RTTP::Client>> clients;
+    std::atomic<uint8_t> joined(0);
+    screen.assertTrue("Screen_ClientsJoined", joinClients(clients, joined));
+
+    Host::setTime(0);
+    Time.setTimezone(7);
+    Time.adjust(TIMESTAMP);
+
+    checkScreen(screen, "boot", []() { Display::showBootMessage(); });
+    checkScreen(screen, "datetime", []() { Display::switchDisplay(); });
+    checkScreen(screen, "schedule", []() { Display::switchDisplay(); });
+
+    uint32_t bytes = g_OLED.getBusBytes();
+    Display::switchDisplay();
+    g_OLED.waitForTransfer();
+    screen.assertEqual("Screen_HoldSendsNothing", 0, g_OLED.getBusBytes() - bytes);
+
+    screen.assertTrue("Screen_SurahScrolls", Display::isSurahScrolling);
+    screen.assertTrue("Screen_DeviceScrolls", Display::isDeviceScrolling);
+    checkScreen(screen, "scrolled", []() {
+        for (uint8_t i = 0; i < 40; i++) {
+            Display::scrollDisplay();
+        }
+    });
+
+    checkScreen(screen, "qiro", []() {
+        Display::isQiroActive = true;
+        Display::showPrayerOngoing();
+        Display::showSurahOngoing();
+    });
+    Display::isQiroActive = false;
+    Display::showSurahOngoing();
+    g_OLED.waitForTransfer();
+
+    bytes               = g_OLED.getBusBytes();
+    uint32_t panelBytes = panel.getBytes();
+    auto start          = std::chrono::steady_clock::now();
+    for (uint16_t i = 0; i < SCROLL_FRAMES; i++) {
+        Display::scrollDisplay();
+        g_OLED.waitForTransfer();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    bytes      = g_OLED.getBusBytes() - bytes;
+    panelBytes = panel.getBytes() - panelBytes;
+
+    screen.assertEqual("Screen_ScrollBytesCounted", panelBytes, bytes);
+    screen.assertTrue("Screen_ScrollPanelShowsBuffer", isShowingBuffer());
+
+    screen.attach(Host::console);
+    UnitTest::Result result = screen.run();
+
+    double bytesPerFrame = (double)bytes / SCROLL_FRAMES;
+    Host::console.printf(
+        "scroll       %8.1f us/frame, %6.1f bytes/frame, %7.0f bytes/s at %u ms per frame\n",
+        elapsed.count() / SCROLL_FRAMES, bytesPerFrame, bytesPerFrame * 1000 / SCROLL_INTERVAL, SCROLL_INTERVAL
+    );
+
+    clients.clear();
+    return result.failed > 0;
+}
@@ -0,0 +1,92 @@
+#include <Host.h>
+#include <UnitTest/UnitTest.h>
+
+#include <random>
+
+#include "Config.h"
+#include "Display.h"
+
+/**
+ * This test compares the scrolling of Display.h, which renders a line once with
+ * renderStrip and copies its columns with drawColumns, with printing the line again
+ * at every position with setCursor and print. It scrolls a line of every printable
+ * character across the rows the firmware uses, 44 and 56, across a row aligned to
+ * no page, and across the last rows where the line is clipped. The buffers must be
+ * equal at every offset, over random content around the line.
+ */
+
+namespace {
+
+const int16_t ROWS[]  = {44, 56, 21, 60};
+const uint8_t ADDRESS = 0x3C;
+
+bool isSame(Adafruit_SSD1306& display, Adafruit_SSD1306& reference) {
+    return memcmp(display.getBuffer(), reference.getBuffer(), display.width() * display.height() / 8) == 0;
+}
+
+/**
+ * @brief Scroll a line across a row, once through every offset and back to the right edge.
+ *
+ * @param reference is the display the line is printed on.
+ * @param text is the line.
+ * @param y is the top row of the line.
+ * @param isWrapped is set to true if the line went back to the right edge after its last offset.
+ * @return the first offset where the displays differ, or an empty string if none does.
+ */
+String compareRow(Adafruit_SSD1306& reference, const String& text, const int16_t& y, bool& isWrapped) {
+    std::mt19937 random(y);
+    for (int16_t i = 0; i < g_OLED.width() * g_OLED.height() / 8; i++) {
+        g_OLED.getBuffer()[i] = reference.getBuffer()[i] = random();
+    }
+
+    std::vector<uint8_t> strip;
+    Display::renderStrip(text, strip);
+
+    int16_t x = g_OLED.width() + 1;
+    for (int16_t offset = g_OLED.width(); offset >= -(int16_t)strip.size(); offset--) {
+        Display::scrollStrip(strip, x, y);
+
+        reference.fillRect(0, y, reference.width(), 8, SSD1306_BLACK);
+        reference.setCursor(offset, y);
+        reference.print(text);
+
+        if (x != offset) {
+            return "the strip is at " + String(x) + " instead of " + String(offset);
+        }
+        if (!isSame(g_OLED, reference)) {
+            return "the displays differ at x = " + String(offset);
+        }
+    }
+
+    Display::scrollStrip(strip, x, y);
+    isWrapped = x == g_OLED.width();
+    return "";
+}
+
+};  // namespace
+
+int main() {
+    UnitTest scroll("ScrollStrip Unit Test");
+
+    String text;
+    for (char c = ' '; c <= '~'; c++) {
+        text += c;
+    }
+
+    Adafruit_SSD1306 reference(128, 64);
+    g_OLED.begin(SSD1306_SWITCHCAPVCC, ADDRESS);
+    reference.begin(SSD1306_SWITCHCAPVCC, ADDRESS);
+    reference.setTextWrap(false);
+    reference.setTextColor(SSD1306_WHITE);
+    reference.setTextSize(1);
+
+    for (int16_t y : ROWS) {
+        bool isWrapped = false;
+        scroll.assertEqual("ScrollStrip_MatchesPrintAtRow" + String(y), "", compareRow(reference, text, y, isWrapped));
+        scroll.assertTrue("ScrollStrip_WrapsAtRow" + String(y), isWrapped);
+    }
+
+    scroll.attach(Host::console);
+    UnitTest::Result result = scroll.run();
+    return result.failed > 0;
+}
@@ -0,0 +1,187 @@
+#include <Host.h>
+#include <Timer/Timer.h>
+#include <UnitTest/UnitTest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+/**
+ * This test drives the timer from the main task, which owns it, on the stopped clock,
+ * and starts, resets and destroys countdown timers from another task, as Sequence does
+ * from the executor. The requests of that task carry its time, and a timer destroyed
+ * on it is cancelled by the owner before its memory is freed. Build it with
+ * HOST_SANITIZE_THREAD to run it under ThreadSanitizer.
+ *
+ * It then prints how long run() takes with 1, 10, 100 and 1000 pending timeouts,
+ * when nothing is due and when an interval among them is due on every tick.
+ */
+
+namespace {
+
+const uint32_t DURATION       = 100;
+const uint32_t WAIT_TIMEOUT   = 2000;
+const uint32_t BENCHMARK_TIME = 10000;
+const uint32_t TICKS          = 100000;
+const uint16_t PENDING[]      = {1, 10, 100, 1000};
+
+std::atomic<uint32_t> calls(0);
+
+/**
+ * @brief Work for a task: start, reset or destroy a countdown timer.
+ *
+ */
+struct Job {
+    enum Action {
+        Start,
+        Reset,
+        Destroy
+    };
+
+    Action action;
+    CountDownTimer* timer;
+    std::atomic<bool> isDone{false};
+};
+
+void runJob(void* ptr) {
+    Job* job = (Job*)ptr;
+    if (job->action == Job::Start) {
+        job->timer->start();
+    } else if (job->action == Job::Reset) {
+        job->timer->reset();
+    } else {
+        delete job->timer;
+    }
+    job->isDone = true;
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Wait in real time, so the stopped clock stays where the test put it.
+ *
+ * @param job is the job to wait for.
+ * @param isRunning is true to run the timer meanwhile.
+ * @return true if the job is done in time.
+ */
+bool waitFor(const Job& job, const bool& isRunning) {
+    for (uint32_t i = 0; i < WAIT_TIMEOUT && !job.isDone; i++) {
+        if (isRunning) {
+            Timer::run();
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return job.isDone;
+}
+
+/**
+ * @brief Run a job on another task than the one that owns the timer.
+ *
+ * @param job is the job.
+ * @return true if the job is done in time.
+ */
+bool runOnTask(Job& job) {
+    xTaskCreate(runJob, "job", 4096, &job, 1, NULL);
+    return waitFor(job, false);
+}
+
+/**
+ * @brief Move the stopped clock and run the timer.
+ *
+ * @return how many countdowns ended.
+ */
+uint32_t runAt(const uint32_t& time) {
+    uint32_t before = calls;
+    Host::setTime(time);
+    Timer::run();
+    return calls - before;
+}
+
+/**
+ * @brief Time run() with pending timeouts that are not due yet.
+ * The clock moves by 1 ms per tick in the second pass, which is included in its time.
+ *
+ * @param pending is the number of pending timeouts.
+ */
+void benchmark(const uint16_t& pending) {
+    Host::setTime(BENCHMARK_TIME);
+    std::vector<TimeHandle_t> timeouts;
+    for (uint16_t i = 0; i < pending; i++) {
+        timeouts.push_back(Timer::setTimeout([]() {}, 3600000 + i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TICKS; i++) {
+        Timer::run();
+    }
+    std::chrono::duration<double, std::nano> idle = std::chrono::steady_clock::now() - start;
+
+    TimeHandle_t interval = Timer::setInterval([]() {}, 1);
+    start                 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < TICKS; i++) {
+        Host::advanceTime(1);
+        Timer::run();
+    }
+    std::chrono::duration<double, std::nano> due = std::chrono::steady_clock::now() - start;
+
+    Timer::clearInterval(interval);
+    for (const TimeHandle_t& timeout : timeouts) {
+        Timer::clearTimeout(timeout);
+    }
+    Timer::run();
+
+    Host::console.printf(
+        "run() %5u pending %8.1f ns/tick idle, %8.1f ns/tick with an interval due\n", pending,
+        idle.count() / TICKS, due.count() / TICKS
+    );
+}
+
+};  // namespace
+
+int main() {
+    UnitTest timer("Timer Unit Test");
+
+    Host::setTime(1000);
+    Timer::run();
+
+    CountDownTimer countDown(DURATION, []() { calls++; });
+
+    // The owner applies the request 80 ms after the task asked, but counts from the time of the task.
+    Job start{Job::Start, &countDown};
+    timer.assertTrue("CountDown_StartOnTaskReturns", runOnTask(start));
+    timer.assertEqual("CountDown_StartOnTaskNotEarly", 0, runAt(1080));
+    timer.assertEqual("CountDown_StartOnTaskKeepsItsTime", 1, runAt(1100));
+    timer.assertTrue("CountDown_EndsAfterItsDuration", !countDown.isRunning());
+
+    countDown.start();
+    Host::setTime(1150);
+    Job reset{Job::Reset, &countDown};
+    timer.assertTrue("CountDown_ResetOnTaskReturns", runOnTask(reset));
+    timer.assertEqual("CountDown_ResetOnTaskNotEarly", 0, runAt(1200));
+    timer.assertEqual("CountDown_ResetOnTaskKeepsItsTime", 1, runAt(1250));
+
+    // A stopped timer is not started by a reset.
+    Host::setTime(1300);
+    Job idle{Job::Reset, &countDown};
+    runOnTask(idle);
+    timer.assertEqual("CountDown_ResetOnTaskLeavesStoppedTimer", 0, runAt(1500));
+
+    // The task blocks in the destructor until the owner has cancelled the timer.
+    Host::setTime(2000);
+    CountDownTimer* doomed = new CountDownTimer(DURATION, []() { calls++; });
+    doomed->start();
+    Job destroy{Job::Destroy, doomed};
+    xTaskCreate(runJob, "job", 4096, &destroy, 1, NULL);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    timer.assertTrue("CountDown_DestroyOnTaskWaitsForOwner", !destroy.isDone);
+    timer.assertTrue("CountDown_DestroyOnTaskReturnsOnceCancelled", waitFor(destroy, true));
+    timer.assertEqual("CountDown_DestroyedNeverEnds", 0, runAt(2000 + 2 * DURATION));
+
+    timer.attach(Host::console);
+    UnitTest::Result result = timer.run();
+
+    for (uint16_t pending : PENDING) {
+        benchmark(pending);
+    }
+    return result.failed > 0;
+}
@@ -0,0 +1,340 @@
+#include <Host.h>
+#include <Simulator/FlashSimulator.h>
+#include <TinyDB/TinyDB.h>
+#include <TinyDB/TinyLog.h>
+#include <UnitTest/UnitTest.h>
+
+#include <map>
+
+/**
+ * This test cuts the power of the flash under TinyLog and TinyDB. The flash is
+ * mounted behind a file system that stops writing once a byte budget is spent, so
+ * the write that crosses it is torn and every later write fails. Each case spends
+ * the budget at one step: in the middle of an append, while the compaction file
+ * is written, after it is written, after the log is removed, and while the Files
+ * engine is imported. It checks the files left behind, that the log turns read-only
+ * when a write could lose records and writable once the power is back, and that
+ * the next begin() recovers every value written completely.
+ */
+
+namespace {
+
+const char* LOG_PATH        = "/tinydb.log";
+const char* COMPACTION_PATH = "/tinydb.log.tmp";
+const char* IMPORT_PATH     = "/tinydb.log.import";
+const uint32_t UNLIMITED    = 0xFFFFFFFF;
+const uint16_t LARGE_LENGTH = TINYLOG_CACHE_VALUE_SIZE + 500;
+const uint8_t HEADER_SIZE   = 9;
+
+/**
+ * @brief Count the bytes written against a budget shared by the files of a file system.
+ *
+ */
+class Budget {
+   public:
+    /**
+     * @brief Take bytes from the budget.
+     *
+     * @param size is the number of bytes to write.
+     * @return the number of bytes that can be written before the power is cut.
+     */
+    uint32_t take(const uint32_t& size) {
+        uint32_t taken = min(size, m_Remaining);
+        if (m_Remaining != UNLIMITED) {
+            m_Remaining -= taken;
+        }
+        return taken;
+    }
+
+    void set(const uint32_t& remaining) {
+        m_Remaining = remaining;
+    }
+
+   private:
+    uint32_t m_Remaining = UNLIMITED;
+};
+
+/**
+ * @brief A file that takes the bytes it writes from a budget.
+ *
+ */
+class CutFile : public fs::FileImpl {
+   public:
+    CutFile(const File& file, Budget& budget)
+        : m_File(file), m_Budget(budget) {}
+
+    size_t write(const uint8_t* buf, size_t size) override { return m_File.write(buf, m_Budget.take(size)); }
+    size_t read(uint8_t* buf, size_t size) override { return m_File.read(buf, size); }
+    void flush() override { m_File.flush(); }
+    bool seek(uint32_t pos, fs::SeekMode mode) override { return m_File.seek(pos, mode); }
+    size_t position() const override { return m_File.position(); }
+    size_t size() const override { return m_File.size(); }
+    bool setBufferSize(size_t size) override { return m_File.setBufferSize(size); }
+    void close() override { m_File.close(); }
+    time_t getLastWrite() override { return m_File.getLastWrite(); }
+    const char* path() const override { return m_File.path(); }
+    const char* name() const override { return m_File.name(); }
+    boolean isDirectory() override { return m_File.isDirectory(); }
+    boolean seekDir(long position) override { return false; }
+    String getNextFileName() override { return m_File.getNextFileName(); }
+    String getNextFileName(bool* isDir) override { return m_File.getNextFileName(); }
+    void rewindDirectory() override { m_File.rewindDirectory(); }
+    operator bool() override { return m_File; }
+
+    fs::FileImplPtr openNextFile(const char* mode) override {
+        File next = m_File.openNextFile(mode);
+        return next ? std::make_shared<CutFile>(next, m_Budget) : fs::FileImplPtr();
+    }
+
+   private:
+    File m_File;
+    Budget& m_Budget;
+};
+
+/**
+ * @brief A file system that forwards to another one until its budget is spent.
+ * Creating, truncating, removing or renaming a file writes its metadata, which takes one byte.
+ * Reads still work once the power is cut, so the files left behind can be checked.
+ *
+ */
+class CutFS : public fs::FSImpl {
+   public:
+    CutFS(fs::FS& target, Budget& budget)
+        : m_Target(target), m_Budget(budget) {}
+
+    fs::FileImplPtr open(const char* path, const char* mode, const bool create) override {
+        bool isCreated = mode[0] == 'w' || (mode[0] == 'a' && !m_Target.exists(path));
+        if (isCreated && m_Budget.take(1) == 0) {
+            return fs::FileImplPtr();
+        }
+
+        File file = m_Target.open(path, mode, create);
+        return file ? std::make_shared<CutFile>(file, m_Budget) : fs::FileImplPtr();
+    }
+
+    bool exists(const char* path) override { return m_Target.exists(path); }
+    bool rename(const char* pathFrom, const char* pathTo) override { return m_Budget.take(1) && m_Target.rename(pathFrom, pathTo); }
+    bool remove(const char* path) override { return m_Budget.take(1) && m_Target.remove(path); }
+    bool mkdir(const char* path) override { return m_Budget.take(1) && m_Target.mkdir(path); }
+    bool rmdir(const char* path) override { return m_Budget.take(1) && m_Target.rmdir(path); }
+
+   private:
+    fs::FS& m_Target;
+    Budget& m_Budget;
+};
+
+/**
+ * @brief A flash whose power can be cut.
+ *
+ */
+struct Device {
+    FlashSimulator flash;
+    Budget budget;
+    fs::FS fs;
+
+    Device()
+        : fs(std::make_shared<CutFS>(flash, budget)) {}
+};
+
+typedef std::map<String, String> Values;
+
+/**
+ * @brief Write values with overwritten and removed ones between them, so a compaction has garbage to drop.
+ * The large value is not cached, so reading it checks the offset of its record.
+ *
+ * @param log is the log to write to.
+ * @return the values the log holds.
+ */
+Values fill(TinyLog& log) {
+    String large;
+    for (uint16_t i = 0; i < LARGE_LENGTH; i++) {
+        large += (char)('a' + i % 26);
+    }
+
+    log.put("alpha", "1");
+    log.put("beta", "22");
+    log.put("large", large);
+    log.put("gamma", "333");
+    log.put("alpha", "one");
+    log.remove("beta");
+    return {{"alpha", "one"}, {"gamma", "333"}, {"large", large}};
+}
+
+bool hasValues(TinyLog& log, const Values& values) {
+    if (log.getKeys().size() != values.size()) {
+        return false;
+    }
+    for (auto& entry : values) {
+        String value;
+        if (!log.get(entry.first, value) || value != entry.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Bring the power back and open the log again.
+ *
+ * @param device is the device to restart.
+ * @param values are the values the log must hold.
+ * @return true if the log was recovered with these values and no compaction file is left. false otherwise.
+ */
+bool restarts(Device& device, const Values& values) {
+    device.budget.set(UNLIMITED);
+    TinyLog log;
+    bool isBegun = log.begin(device.fs);
+    return isBegun && !log.isReadOnly() && hasValues(log, values) && !device.fs.exists(COMPACTION_PATH);
+}
+
+/**
+ * @brief Cut the power during a compaction.
+ *
+ * @param test is the unit test to add the assertions to.
+ * @param name is the name of the case.
+ * @param extra is the budget left past the compaction file, or minus half of the file to tear it.
+ * @param isLogKept is true if the log must still exist after the compaction failed.
+ */
+void cutCompaction(UnitTest& test, const String& name, const int32_t& extra, const bool& isLogKept) {
+    Device device;
+    TinyLog log;
+    log.begin(device.fs);
+    Values values = fill(log);
+
+    // Creating the compaction file takes one byte, then the live records are copied to it.
+    uint32_t live = log.getSize() - log.getGarbageSize();
+    device.budget.set(1 + (extra < 0 ? live / 2 : live + extra));
+    test.assertTrue("TinyLog_" + name + "_Fails", !log.compact());
+    test.assertEqual("TinyLog_" + name + "_KeepsLog", isLogKept, device.fs.exists(LOG_PATH));
+    test.assertTrue("TinyLog_" + name + "_LeavesCompactionFile", device.fs.exists(COMPACTION_PATH));
+    test.assertEqual("TinyLog_" + name + "_ReadOnly", !isLogKept, log.isReadOnly());
+    test.assertTrue("TinyLog_" + name + "_Recovers", restarts(device, values));
+}
+
+/**
+ * @brief Write files with the Files engine, the way the firmware did before the log.
+ *
+ * @param device is the device to write to.
+ * @return the values in the files.
+ */
+std::map<String, int> writeFiles(Device& device) {
+    std::map<String, int> values = {{"alarm", 7}, {"brightness", 200}, {"city", 1234567}, {"method", 3}};
+    TinyDB db;
+    db.begin(device.fs);
+    for (auto& entry : values) {
+        db.put(entry.first, entry.second);
+    }
+    return values;
+}
+
+bool hasImported(Device& device, const std::map<String, int>& values) {
+    TinyDB db;
+    db.begin(device.fs, TinyDB::Log);
+    for (auto& entry : values) {
+        if (db.get(entry.first).serialize() != Any(entry.second).serialize()) {
+            return false;
+        }
+    }
+    return !device.fs.exists(IMPORT_PATH);
+}
+
+/**
+ * @brief Cut the power during the import of the Files engine into the log.
+ *
+ * @param test is the unit test to add the assertions to.
+ * @param name is the name of the case.
+ * @param isTorn is true to cut the power while the import is written, false to cut it before its rename.
+ */
+void cutImport(UnitTest& test, const String& name, const bool& isTorn) {
+    Device reference;
+    writeFiles(reference);
+    TinyDB imported;
+    imported.begin(reference.fs, TinyDB::Log);
+    uint32_t size = reference.fs.open(LOG_PATH).size();
+
+    Device device;
+    std::map<String, int> values = writeFiles(device);
+
+    // Creating the import takes one byte, then its records are appended to it.
+    device.budget.set(1 + (isTorn ? size / 2 : size));
+    {
+        TinyDB db;
+        db.begin(device.fs, TinyDB::Log);
+    }
+    test.assertTrue("TinyLog_" + name + "_LeavesImport", device.fs.exists(IMPORT_PATH) && !device.fs.exists(LOG_PATH));
+
+    device.budget.set(UNLIMITED);
+    test.assertTrue("TinyLog_" + name + "_Redone", hasImported(device, values));
+}
+
+};  // namespace
+
+int main() {
+    UnitTest tiny("TinyLog Unit Test");
+
+    {
+        Device device;
+        Values values;
+        {
+            TinyLog log;
+            log.begin(device.fs);
+            values = fill(log);
+
+            device.budget.set((HEADER_SIZE + String("epsilon").length() + 1) / 2);
+            tiny.assertTrue("TinyLog_TornAppend_Fails", !log.put("epsilon", "5"));
+            tiny.assertTrue("TinyLog_TornAppend_EntersReadOnly", log.isReadOnly());
+            tiny.assertTrue("TinyLog_TornAppend_RefusesWrites", !log.put("zeta", "6"));
+            tiny.assertTrue("TinyLog_TornAppend_KeepsValues", hasValues(log, values));
+        }
+
+        TinyLog log;
+        tiny.assertTrue("TinyLog_TornLog_BeginsReadOnly", !log.begin(device.fs) && log.isReadOnly());
+        tiny.assertTrue("TinyLog_TornLog_KeepsValues", hasValues(log, values));
+
+        device.budget.set(UNLIMITED);
+        tiny.assertTrue("TinyLog_TornLog_LeavesReadOnly", log.put("zeta", "6") && !log.isReadOnly());
+        values["zeta"] = "6";
+        tiny.assertTrue("TinyLog_TornLog_DropsTornRecord", restarts(device, values));
+    }
+
+    cutCompaction(tiny, "TornCompaction", -1, true);
+    cutCompaction(tiny, "CompactionWritten", 0, true);
+    cutCompaction(tiny, "LogRemoved", 1, false);
+
+    {
+        Device device;
+        TinyLog log;
+        log.begin(device.fs);
+        Values values = fill(log);
+
+        device.budget.set(3 + log.getSize() - log.getGarbageSize());
+        tiny.assertTrue("TinyLog_Compaction_Succeeds", log.compact() && !log.isReadOnly());
+        tiny.assertTrue("TinyLog_Compaction_Recovers", restarts(device, values));
+    }
+
+    {
+        // The rename fails but the power comes back before the next begin(): the next compaction renames it first.
+        Device device;
+        TinyLog log;
+        log.begin(device.fs);
+        Values values = fill(log);
+
+        device.budget.set(2 + log.getSize() - log.getGarbageSize());
+        log.compact();
+        tiny.assertTrue("TinyLog_RenameFailed_RefusesWrites", !log.put("zeta", "6"));
+
+        device.budget.set(UNLIMITED);
+        tiny.assertTrue("TinyLog_RenameFailed_LeavesReadOnly", log.compact() && !log.isReadOnly());
+        tiny.assertTrue("TinyLog_RenameFailed_Writes", log.put("zeta", "6"));
+        values["zeta"] = "6";
+        tiny.assertTrue("TinyLog_RenameFailed_KeepsValues", hasValues(log, values));
+        tiny.assertTrue("TinyLog_RenameFailed_Recovers", restarts(device, values));
+    }
+
+    cutImport(tiny, "TornImport", true);
+    cutImport(tiny, "ImportNotRenamed", false);
+
+    tiny.attach(Host::console);
+    UnitTest::Result result = tiny.run();
+    return result.failed > 0;
+}
@@ -0,0 +1,405 @@
+#include <Host.h>
+#include <RTTP/Server.h>
+#include <UnitTest/UnitTest.h>
+#include <WebSocket/WSClient.h>
+#include <WebSocket/WSServer.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * This test connects WSClients to a WSServer and to an RTTP server of the same
+ * program through the loopback network of the host, on the real clock, with the
+ * polling tasks of the firmware.
+ *
+ * The client sends masked binary messages of 0 to 8192 bytes, across the 125 and
+ * 126 byte boundaries of the header and the chunks the payload is masked in, which
+ * the server echoes back, also over a slow link that splits the header and the payload
+ * across several polls. A message of 9000 bytes closes the connection with 1009.
+ *
+ * It then uploads a bulk transfer to the RTTP server. The link is cut in the middle
+ * of the first message, and a new connection resumes from the offset the server
+ * replies with. The transfer ends with Info when its checksum matches, and another
+ * one ends with Delete when its checksum is wrong.
+ */
+
+namespace {
+
+const uint16_t ECHO_PORT     = 8081;
+const uint16_t RTTP_PORT     = 8082;
+const uint32_t WAIT_TIMEOUT  = 5000;
+const size_t TOO_BIG         = 9000;
+const size_t TRANSFER_LENGTH = 20000;
+const size_t CUT_LENGTH      = 7001;
+const size_t MASKED_HEADER   = 8;
+const size_t SEGMENT_LENGTH  = 3;
+const uint32_t SEGMENT_GAP   = 2;
+const size_t SPLIT_LENGTH    = 300;
+const String CLIENT_ID       = "uploader";
+const size_t ECHO_LENGTHS[]  = {0, 1, 2, 3, 4, 5, 124, 125, 126, 127, 128, 129, 255, 256, 1000, 4096, 8191, 8192};
+
+/**
+ * @brief A connection whose link can be slowed down, so frames arrive in several pieces,
+ * or cut after a number of bytes, like one that drops in the middle of a frame.
+ * What is written after the cut is lost.
+ *
+ */
+class Link : public TCPClient {
+   public:
+    /**
+     * @brief Send every write in segments a few milliseconds apart.
+     *
+     * @param length is the length of a segment.
+     */
+    void splitInto(const size_t& length) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Segment = length;
+    }
+
+    /**
+     * @brief Cut the link once more bytes have been sent.
+     *
+     * @param length is the number of bytes that still reach the peer.
+     */
+    void cutAfter(const size_t& length) {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Budget = length;
+    }
+
+    int read(uint8_t* buffer, size_t length) override {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Client.available() ? m_Client.read(buffer, length) : -1;
+    }
+
+    int available() override {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Client.available();
+    }
+
+    int connected() override {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Client.connected();
+    }
+
+    IPAddress remoteIP() override {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Client.remoteIP();
+    }
+
+    uint16_t remotePort() override {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Client.remotePort();
+    }
+
+   protected:
+    bool connect(const String& host, const uint16_t& port) override {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Client.connect(host.c_str(), port);
+    }
+
+    void disconnect() override {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Client.stop();
+    }
+
+    size_t transmit(const uint8_t* data, size_t length) override {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        length      = min(length, m_Budget);
+        size_t sent = 0;
+        while (sent < length) {
+            if (sent > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(SEGMENT_GAP));
+            }
+            size_t written = m_Client.write(data + sent, min(length - sent, m_Segment));
+            if (written == 0) {
+                break;
+            }
+            sent += written;
+        }
+
+        if (m_Budget != SIZE_MAX) {
+            m_Budget -= sent;
+            if (m_Budget == 0) {
+                m_Client.stop();
+            }
+        }
+        return sent;
+    }
+
+   private:
+    std::mutex m_Mutex;
+    WiFiClient m_Client;
+    size_t m_Segment = SIZE_MAX;
+    size_t m_Budget  = SIZE_MAX;
+};
+
+/**
+ * @brief What a client received, from its polling task.
+ *
+ */
+struct Inbox {
+    std::mutex mutex;
+    std::vector<std::vector<uint8_t>> messages;
+    std::vector<RTTP::Message> transfers;
+    std::atomic<int32_t> closeCode{-1};
+
+    void listen(WSClient& client) {
+        client.onBinaryMessage([this](WSClient& c, const uint8_t* data, const size_t& length) {
+            std::lock_guard<std::mutex> lock(mutex);
+            messages.emplace_back(data, data + length);
+        });
+        client.onTextMessage([this](WSClient& c, const String& text) {
+            RTTP::Message message = Any::parse(text);
+            if (message && message.topic == RTTP::TRANSFER_TOPIC) {
+                std::lock_guard<std::mutex> lock(mutex);
+                transfers.push_back(message);
+            }
+        });
+        client.onClose([this](WSClient& c, const WSClient::CloseReason& code, const String& reason) {
+            closeCode = (int32_t)code;
+        });
+    }
+
+    size_t countMessages() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return messages.size();
+    }
+
+    size_t countTransfers() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return transfers.size();
+    }
+};
+
+/**
+ * @brief What the channel of the RTTP server received, from the server task.
+ *
+ */
+struct Upload {
+    std::mutex mutex;
+    std::vector<uint8_t> content;
+    std::vector<uint32_t> offsets;
+    std::vector<bool> results;
+
+    size_t countContent() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return content.size();
+    }
+};
+
+/**
+ * @brief Wait in real time for the polling tasks.
+ *
+ * @param isDone returns true once there is nothing left to wait for.
+ * @return true if it did not time out.
+ */
+template <class Predicate>
+bool waitUntil(Predicate isDone) {
+    for (uint32_t i = 0; i < WAIT_TIMEOUT && !isDone(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return isDone();
+}
+
+std::vector<uint8_t> makeContent(const size_t& length, const uint8_t& seed) {
+    std::vector<uint8_t> content(length);
+    for (size_t i = 0; i < length; i++) {
+        content[i] = (i * 31 + seed) & 0xFF;
+    }
+    return content;
+}
+
+/**
+ * @brief Send a message to the echo server and wait for it to come back.
+ *
+ * @return true if the same message came back.
+ */
+bool echo(WSClient& client, Inbox& inbox, const size_t& length) {
+    std::vector<uint8_t> content = makeContent(length, length);
+    if (!client.sendBinary(content.data(), content.size())
+        || !waitUntil([&inbox]() { return inbox.countMessages() > 0; })) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(inbox.mutex);
+    bool isSame = inbox.messages[0] == content;
+    inbox.messages.clear();
+    return isSame;
+}
+
+/**
+ * @brief Connect to the upload channel and authenticate.
+ *
+ * @return true if the server accepted the client.
+ */
+bool join(WSClient& client, Inbox& inbox) {
+    inbox.listen(client);
+    if (!client.begin("ws://127.0.0.1:" + String(RTTP_PORT) + "/rttp/upload", false)) {
+        return false;
+    }
+
+    String auth = RTTP::Auth(CLIENT_ID, "Uploader", "secret").serialize();
+    client.sendBinary((const uint8_t*)auth.c_str(), auth.length());
+    if (!waitUntil([&inbox]() { return inbox.countMessages() > 0; })) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(inbox.mutex);
+    String text;
+    text.concat((const char*)inbox.messages[0].data(), inbox.messages[0].size());
+    return text == "auth-ok";
+}
+
+/**
+ * @brief Wait for a reply of the server about a transfer.
+ *
+ * @param count is the number of replies received before.
+ * @return the reply, or an invalid message if there is none.
+ */
+RTTP::Message awaitReply(Inbox& inbox, const size_t& count) {
+    if (!waitUntil([&inbox, &count]() { return inbox.countTransfers() > count; })) {
+        return RTTP::Message();
+    }
+
+    std::lock_guard<std::mutex> lock(inbox.mutex);
+    return inbox.transfers[count];
+}
+
+/**
+ * @brief Announce a transfer and wait for the reply of the server.
+ *
+ * @return the reply, or an invalid message if there is none.
+ */
+RTTP::Message announce(WSClient& client, Inbox& inbox, const RTTP::Transfer& transfer) {
+    size_t count = inbox.countTransfers();
+    client.sendText(
+        RTTP::Message(CLIENT_ID, RTTP::SERVER_ID, RTTP::TRANSFER_TOPIC, RTTP::Message::Set, transfer).serialize()
+    );
+    return awaitReply(inbox, count);
+}
+
+bool isReply(const RTTP::Message& reply, const RTTP::Message::Action& action, const uint32_t& offset) {
+    RTTP::Transfer transfer = reply.payload;
+    return reply && reply.action == action && transfer && transfer.offset == offset;
+}
+
+};  // namespace
+
+int main() {
+    UnitTest websocket("WebSocket Unit Test");
+    Host::setConnected(true);
+
+    WSServer echoServer(ECHO_PORT);
+    echoServer.onConnection("/echo", [](std::shared_ptr<WSClient> client) {
+        client->onBinaryMessage([](WSClient& c, const uint8_t* data, const size_t& length) {
+            c.sendBinary(data, length);
+        });
+    });
+    echoServer.begin();
+
+    WSClient client;
+    Inbox inbox;
+    inbox.listen(client);
+    websocket.assertTrue("WebSocket_Connects", client.begin("ws://127.0.0.1:" + String(ECHO_PORT) + "/echo", false));
+
+    for (size_t length : ECHO_LENGTHS) {
+        websocket.assertTrue("WebSocket_RoundTrips" + String(length) + "Bytes", echo(client, inbox, length));
+    }
+
+    // The header and the payload of the frames arrive in pieces, over several polls of the server.
+    std::shared_ptr<Link> slowLink = std::make_shared<Link>();
+    WSClient slow(slowLink);
+    Inbox slowInbox;
+    slowInbox.listen(slow);
+    slow.begin("ws://127.0.0.1:" + String(ECHO_PORT) + "/echo", false);
+    slowLink->splitInto(SEGMENT_LENGTH);
+    websocket.assertTrue("WebSocket_RoundTripsSplitFrames", echo(slow, slowInbox, SPLIT_LENGTH));
+    websocket.assertTrue("WebSocket_RoundTripsAfterSplitFrames", echo(slow, slowInbox, ECHO_LENGTHS[2]));
+
+    std::vector<uint8_t> tooBig = makeContent(TOO_BIG, 0);
+    client.sendBinary(tooBig.data(), tooBig.size());
+    waitUntil([&inbox]() { return inbox.closeCode >= 0; });
+    websocket.assertEqual("WebSocket_ClosesTooBigWith1009", 1009, (int32_t)inbox.closeCode);
+
+    Upload upload;
+    RTTP::Server rttp(RTTP_PORT);
+    rttp.createChannel("upload")
+        .onAuth([](const RTTP::Auth& auth) { return auth.id == CLIENT_ID; })
+        .onTransfer([&upload](const RTTP::Transfer& transfer) {
+            std::lock_guard<std::mutex> lock(upload.mutex);
+            upload.offsets.push_back(transfer.offset);
+            upload.content.resize(transfer.offset);
+            return true;
+        })
+        .onTransferData([&upload](const RTTP::Transfer& transfer, const uint8_t* data, const size_t& length) {
+            std::lock_guard<std::mutex> lock(upload.mutex);
+            upload.content.insert(upload.content.end(), data, data + length);
+            return upload.content.size() == transfer.offset + length;
+        })
+        .onTransferEnd([&upload](const RTTP::Transfer& transfer, const bool& isValid) {
+            std::lock_guard<std::mutex> lock(upload.mutex);
+            upload.results.push_back(isValid);
+        });
+    rttp.begin();
+
+    std::vector<uint8_t> content = makeContent(TRANSFER_LENGTH, 7);
+    uint32_t checksum            = Crypto::crc32(content.data(), content.size());
+    RTTP::Transfer transfer("surahs.idx", TRANSFER_LENGTH, checksum);
+
+    // The link drops in the middle of the message, so the server keeps what came before the cut.
+    std::shared_ptr<Link> link = std::make_shared<Link>();
+    WSClient cut(link);
+    Inbox cutInbox;
+    websocket.assertTrue("Transfer_Joins", join(cut, cutInbox));
+    websocket.assertTrue("Transfer_StartsAtZero", isReply(announce(cut, cutInbox, transfer), RTTP::Message::Info, 0));
+
+    link->cutAfter(MASKED_HEADER + CUT_LENGTH);
+    cut.sendBinary(content.data(), content.size());
+    websocket.assertTrue(
+        "Transfer_KeepsDataBeforeTheCut", waitUntil([&upload]() { return upload.countContent() == CUT_LENGTH; })
+    );
+
+    WSClient resumed;
+    Inbox resumedInbox;
+    websocket.assertTrue("Transfer_Rejoins", join(resumed, resumedInbox));
+
+    RTTP::Message reply = announce(resumed, resumedInbox, transfer);
+    websocket.assertTrue("Transfer_ResumesAtTheCut", isReply(reply, RTTP::Message::Info, CUT_LENGTH));
+
+    RTTP::Transfer resumeAt = reply.payload;
+    size_t count            = resumedInbox.countTransfers();
+    resumed.sendBinary(content.data() + resumeAt.offset, content.size() - resumeAt.offset);
+    websocket.assertTrue(
+        "Transfer_EndsWithInfo", isReply(awaitReply(resumedInbox, count), RTTP::Message::Info, TRANSFER_LENGTH)
+    );
+
+    {
+        std::lock_guard<std::mutex> lock(upload.mutex);
+        websocket.assertTrue("Transfer_ReceivesTheContent", upload.content == content);
+        websocket.assertTrue("Transfer_IsAcceptedAtEachOffset", upload.offsets == std::vector<uint32_t>{0, CUT_LENGTH});
+        websocket.assertTrue("Transfer_IsValid", upload.results.size() == 1 && upload.results[0]);
+    }
+
+    // The same content announced with another checksum is a new transfer, which fails its check.
+    RTTP::Transfer corrupt("surahs.bad", TRANSFER_LENGTH, checksum ^ 1);
+    websocket.assertTrue(
+        "Transfer_BadStartsAtZero", isReply(announce(resumed, resumedInbox, corrupt), RTTP::Message::Info, 0)
+    );
+
+    count = resumedInbox.countTransfers();
+    resumed.sendBinary(content.data(), content.size());
+    websocket.assertTrue(
+        "Transfer_BadEndsWithDelete", isReply(awaitReply(resumedInbox, count), RTTP::Message::Delete, TRANSFER_LENGTH)
+    );
+    websocket.assertTrue("Transfer_BadIsInvalid", waitUntil([&upload]() {
+                             std::lock_guard<std::mutex> lock(upload.mutex);
+                             return upload.results.size() == 2 && !upload.results[1];
+                         }));
+
+    websocket.attach(Host::console);
+    UnitTest::Result result = websocket.run();
+    return result.failed > 0;
+}
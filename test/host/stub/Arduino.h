@@ -0,0 +1,140 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/**
+ * This file stands in for the Arduino core of the ESP32 on the host.
+ * It only declares what the sources under test use. The functions are
+ * implemented by Host.cpp.
+ */
+
+#include <ctype.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <type_traits>
+
+#define ARDUINO_ARCH_ESP32 1
+
+#define F(string) string
+#define PROGMEM
+#define IRAM_ATTR
+
+#define HIGH 1
+#define LOW 0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define PI 3.1415926535897932384626433832795
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_word(address) (*(const uint16_t*)(address))
+#define pgm_read_dword(address) (*(const uint32_t*)(address))
+#define pgm_read_pointer(address) (*(void* const*)(address))
+
+#define constrain(value, low, high) ((value) < (low) ? (low) : ((value) > (high) ? (high) : (value)))
+#define degrees(radians) ((radians) * RAD_TO_DEG)
+#define radians(degrees) ((degrees) * DEG_TO_RAD)
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef uint16_t word;
+
+#define word(high, low) ((uint16_t)((high) << 8 | (low)))
+
+template <class A, class B>
+typename std::common_type<A, B>::type min(A a, B b) {
+    return a < b ? a : b;
+}
+
+template <class A, class B>
+typename std::common_type<A, B>::type max(A a, B b) {
+    return a > b ? a : b;
+}
+
+#include "WString.h"
+#include "IPAddress.h"
+#include "Print.h"
+#include "Stream.h"
+#include "freertos/FreeRTOS.h"
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+long random(long max);
+long random(long min, long max);
+long map(long value, long fromLow, long fromHigh, long toLow, long toHigh);
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalPinToInterrupt(int pin);
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* argument, int mode);
+void detachInterrupt(uint8_t pin);
+
+// There is no PWM on the host, so the LEDC channels do nothing.
+inline uint32_t ledcSetup(uint8_t channel, uint32_t frequency, uint8_t resolution) { return frequency; }
+inline void ledcAttachPin(uint8_t pin, uint8_t channel) {}
+inline void ledcDetachPin(uint8_t pin) {}
+inline void ledcWrite(uint8_t channel, uint32_t duty) {}
+
+uint16_t htons(uint16_t value);
+uint16_t ntohs(uint16_t value);
+uint32_t htonl(uint32_t value);
+uint32_t ntohl(uint32_t value);
+
+/**
+ * @brief A serial port that prints to the standard output.
+ *
+ */
+class HardwareSerial : public Stream {
+   public:
+    void begin(unsigned long baud, uint32_t config = 0, int8_t rx = -1, int8_t tx = -1) {}
+    size_t write(uint8_t value) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+#define SERIAL_8N1 0x800001c
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+/**
+ * @brief The chip functions. The free heap is reported as 0.
+ *
+ */
+class EspClass {
+   public:
+    uint32_t getFreeHeap() { return 0; }
+    uint32_t getMinFreeHeap() { return 0; }
+    uint32_t getCycleCount() { return micros() * 240; }
+    void restart() { exit(0); }
+};
+
+extern EspClass ESP;
+
+uint32_t esp_random();
+void esp_efuse_mac_get_default(uint8_t* mac);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef HOST_ASYNC_UDP_H
+#define HOST_ASYNC_UDP_H
+
+/**
+ * This file stands in for the asynchronous UDP sockets of the ESP32 on the host.
+ * Nothing is sent and no packet ever arrives.
+ */
+
+#include <functional>
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+class AsyncUDPPacket : public Stream {
+   public:
+    IPAddress remoteIP() { return IPAddress(); }
+    uint16_t remotePort() { return 0; }
+    size_t write(uint8_t value) override { return 0; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+class AsyncUDPMessage : public Print {
+   public:
+    size_t write(uint8_t value) override { return 1; }
+    void flush() {}
+};
+
+class AsyncUDP {
+   public:
+    bool listen(uint16_t port) { return true; }
+    void onPacket(std::function<void(AsyncUDPPacket packet)> handler) {}
+    size_t sendTo(AsyncUDPMessage& message, const IPAddress& ip, uint16_t port) { return 0; }
+    void close() {}
+};
+
+#endif
@@ -0,0 +1,109 @@
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+/**
+ * This file stands in for the file systems of the ESP32 on the host.
+ * As in the Arduino core, File and FS forward to an implementation, so a test
+ * can mount one. Without an implementation, nothing can be read or written.
+ */
+
+#include "Arduino.h"
+#include "FSImpl.h"
+
+#define FILE_READ   "r"
+#define FILE_WRITE  "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+class File : public Stream {
+   public:
+    File(FileImplPtr p = FileImplPtr())
+        : _p(p) {}
+
+    size_t write(uint8_t value) override { return write(&value, 1); }
+    size_t write(const uint8_t* buffer, size_t size) override { return _p ? _p->write(buffer, size) : 0; }
+    int available() override { return _p ? _p->size() - _p->position() : 0; }
+
+    int read() override {
+        uint8_t value;
+        return read(&value, 1) == 1 ? value : -1;
+    }
+
+    int peek() override {
+        if (!_p) return -1;
+        size_t position = _p->position();
+        int value       = read();
+        _p->seek(position, SeekSet);
+        return value;
+    }
+
+    void flush() override {
+        if (_p) _p->flush();
+    }
+
+    size_t read(uint8_t* buffer, size_t size) { return _p ? _p->read(buffer, size) : 0; }
+    bool seek(uint32_t position, SeekMode mode = SeekSet) { return _p ? _p->seek(position, mode) : false; }
+    size_t position() const { return _p ? _p->position() : 0; }
+    size_t size() const { return _p ? _p->size() : 0; }
+    bool setBufferSize(size_t size) { return _p ? _p->setBufferSize(size) : false; }
+    time_t getLastWrite() { return _p ? _p->getLastWrite() : 0; }
+    const char* name() const { return _p ? _p->name() : ""; }
+    const char* path() const { return _p ? _p->path() : ""; }
+    bool isDirectory() { return _p ? _p->isDirectory() : false; }
+    File openNextFile(const char* mode = FILE_READ) { return _p ? File(_p->openNextFile(mode)) : File(); }
+    String getNextFileName() { return _p ? _p->getNextFileName() : ""; }
+    void rewindDirectory() {
+        if (_p) _p->rewindDirectory();
+    }
+
+    void close() {
+        if (_p) {
+            _p->close();
+            _p = NULL;
+        }
+    }
+
+    operator bool() const { return _p && *_p; }
+
+   protected:
+    FileImplPtr _p;
+};
+
+class FS {
+   public:
+    FS(FSImplPtr impl)
+        : _impl(impl) {}
+
+    File open(const char* path, const char* mode = FILE_READ, const bool create = false) {
+        return _impl ? File(_impl->open(path, mode, create)) : File();
+    }
+    File open(const String& path, const char* mode = FILE_READ, const bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+
+    bool exists(const char* path) { return _impl && _impl->exists(path); }
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path) { return _impl && _impl->remove(path); }
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* pathFrom, const char* pathTo) { return _impl && _impl->rename(pathFrom, pathTo); }
+    bool rename(const String& pathFrom, const String& pathTo) { return rename(pathFrom.c_str(), pathTo.c_str()); }
+    bool mkdir(const char* path) { return _impl && _impl->mkdir(path); }
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+    bool rmdir(const char* path) { return _impl && _impl->rmdir(path); }
+    bool rmdir(const String& path) { return rmdir(path.c_str()); }
+
+   protected:
+    FSImplPtr _impl;
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekMode;
+using fs::SeekSet;
+
+#endif
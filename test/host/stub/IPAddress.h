@@ -0,0 +1,31 @@
+#ifndef HOST_IP_ADDRESS_H
+#define HOST_IP_ADDRESS_H
+
+#include <stdint.h>
+
+#include "WString.h"
+
+class IPAddress {
+   public:
+    IPAddress() {}
+    IPAddress(uint32_t address) : m_Address(address) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : m_Address(a | b << 8 | c << 16 | (uint32_t)d << 24) {}
+
+    String toString() const {
+        char buffer[16];
+        snprintf(
+            buffer, sizeof(buffer), "%u.%u.%u.%u", m_Address & 0xFF, m_Address >> 8 & 0xFF, m_Address >> 16 & 0xFF,
+            m_Address >> 24
+        );
+        return String(buffer);
+    }
+
+    bool operator==(const IPAddress& other) const { return m_Address == other.m_Address; }
+    bool operator!=(const IPAddress& other) const { return m_Address != other.m_Address; }
+    operator uint32_t() const { return m_Address; }
+
+   private:
+    uint32_t m_Address = 0;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef HOST_PRINT_H
+#define HOST_PRINT_H
+
+#include <stdarg.h>
+#include <stdint.h>
+
+#include "WString.h"
+
+class Printable;
+
+/**
+ * @brief The Arduino Print. Numbers are printed in decimal or in the given base.
+ *
+ */
+class Print {
+   public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t value) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t written = 0;
+        while (size--) {
+            written += write(*buffer++);
+        }
+        return written;
+    }
+    size_t write(const char* value) { return value ? write((const uint8_t*)value, strlen(value)) : 0; }
+    size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        va_list arguments;
+        va_start(arguments, format);
+        int length = vsnprintf(NULL, 0, format, arguments);
+        va_end(arguments);
+        if (length < 0) {
+            return 0;
+        }
+
+        std::string buffer(length + 1, 0);
+        va_start(arguments, format);
+        vsnprintf(&buffer[0], buffer.size(), format, arguments);
+        va_end(arguments);
+        return write((const uint8_t*)buffer.data(), length);
+    }
+
+    size_t print(const String& value) { return write((const uint8_t*)value.c_str(), value.length()); }
+    size_t print(const char* value) { return write(value); }
+    size_t print(char value) { return write((uint8_t)value); }
+    size_t print(unsigned char value, int base = 10) { return print(String(value, base)); }
+    size_t print(int value, int base = 10) { return print(String(value, base)); }
+    size_t print(unsigned int value, int base = 10) { return print(String(value, base)); }
+    size_t print(long value, int base = 10) { return print(String(value, base)); }
+    size_t print(unsigned long value, int base = 10) { return print(String(value, base)); }
+    size_t print(long long value, int base = 10) { return print(String(value, base)); }
+    size_t print(unsigned long long value, int base = 10) { return print(String(value, base)); }
+    size_t print(double value, int decimals = 2) { return print(String(value, decimals)); }
+    size_t print(const Printable& value);
+
+    size_t println() { return print("\r\n"); }
+    template <class T>
+    size_t println(const T& value) {
+        size_t written = print(value);
+        return written + println();
+    }
+    template <class T>
+    size_t println(const T& value, int format) {
+        size_t written = print(value, format);
+        return written + println();
+    }
+
+    int getWriteError() { return m_WriteError; }
+    void clearWriteError() { m_WriteError = 0; }
+
+   protected:
+    void setWriteError(int error = 1) { m_WriteError = error; }
+
+   private:
+    int m_WriteError = 0;
+};
+
+#include "Printable.h"
+
+inline size_t Print::print(const Printable& value) {
+    return value.printTo(*this);
+}
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+/**
+ * This file stands in for the SPI driver of the ESP32 on the host.
+ * There is no device on the bus, so everything sent is dropped.
+ */
+
+#include "Arduino.h"
+
+#define SPI_HAS_TRANSACTION 1
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+#define SPI_LSBFIRST 0
+#define SPI_MSBFIRST 1
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+class SPISettings {
+   public:
+    SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0) {}
+};
+
+class SPIClass {
+   public:
+    void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) {}
+    void end() {}
+    void beginTransaction(SPISettings settings) {}
+    void endTransaction() {}
+    void setFrequency(uint32_t frequency) {}
+    uint8_t transfer(uint8_t value) { return 0; }
+    void transfer(void* buffer, uint32_t size) {}
+    void write(uint8_t value) {}
+    void write16(uint16_t value) {}
+    void write32(uint32_t value) {}
+    void writeBytes(const uint8_t* buffer, uint32_t size) {}
+    void writePixels(const void* buffer, uint32_t size) {}
+};
+
+extern SPIClass SPI;
+
+#endif
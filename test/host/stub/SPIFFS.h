@@ -0,0 +1,22 @@
+#ifndef HOST_SPIFFS_H
+#define HOST_SPIFFS_H
+
+/**
+ * This file stands in for the SPIFFS partition of the ESP32 on the host.
+ * It has no implementation, so the partition is empty and cannot be written.
+ */
+
+#include "FS.h"
+
+class SPIFFSFS : public fs::FS {
+   public:
+    SPIFFSFS()
+        : FS(fs::FSImplPtr()) {}
+
+    bool begin(bool formatOnFail = false) { return true; }
+    void end() {}
+};
+
+extern SPIFFSFS SPIFFS;
+
+#endif
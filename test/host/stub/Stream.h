@@ -0,0 +1,47 @@
+#ifndef HOST_STREAM_H
+#define HOST_STREAM_H
+
+#include "Print.h"
+
+/**
+ * @brief The Arduino Stream. Reads never wait, since the host streams are in memory.
+ *
+ */
+class Stream : public Print {
+   public:
+    virtual int available() = 0;
+    virtual int read()      = 0;
+    virtual int peek()      = 0;
+
+    void setTimeout(unsigned long timeout) {}
+
+    size_t readBytes(uint8_t* buffer, size_t size) {
+        size_t count = 0;
+        int value;
+        while (count < size && (value = read()) >= 0) {
+            buffer[count++] = value;
+        }
+        return count;
+    }
+    size_t readBytes(char* buffer, size_t size) { return readBytes((uint8_t*)buffer, size); }
+
+    String readString() {
+        String result;
+        int value;
+        while ((value = read()) >= 0) {
+            result += (char)value;
+        }
+        return result;
+    }
+
+    String readStringUntil(char terminator) {
+        String result;
+        int value;
+        while ((value = read()) >= 0 && value != terminator) {
+            result += (char)value;
+        }
+        return result;
+    }
+};
+
+#endif
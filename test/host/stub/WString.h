@@ -0,0 +1,215 @@
+#ifndef HOST_WSTRING_H
+#define HOST_WSTRING_H
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+
+class __FlashStringHelper;
+
+/**
+ * @brief The Arduino String, backed by a std::string.
+ *
+ */
+class String {
+   public:
+    String() {}
+    String(const char* value) : m_Value(value ? value : "") {}
+    String(const std::string& value) : m_Value(value) {}
+    String(char value) : m_Value(1, value) {}
+    String(unsigned char value, unsigned char base = 10) : m_Value(_format(value, base)) {}
+    String(int value, unsigned char base = 10) : m_Value(_format(value, base)) {}
+    String(unsigned int value, unsigned char base = 10) : m_Value(_format(value, base)) {}
+    String(long value, unsigned char base = 10) : m_Value(_format(value, base)) {}
+    String(unsigned long value, unsigned char base = 10) : m_Value(_format(value, base)) {}
+    String(long long value, unsigned char base = 10) : m_Value(_format(value, base)) {}
+    String(unsigned long long value, unsigned char base = 10) : m_Value(_format(value, base)) {}
+    String(short value, unsigned char base = 10) : m_Value(_format(value, base)) {}
+    String(unsigned short value, unsigned char base = 10) : m_Value(_format(value, base)) {}
+    String(float value, unsigned int decimals = 2) : String((double)value, decimals) {}
+    String(double value, unsigned int decimals = 2) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+        m_Value = buffer;
+    }
+
+    unsigned int length() const { return m_Value.size(); }
+    const char* c_str() const { return m_Value.c_str(); }
+    char* begin() { return &m_Value[0]; }
+    char* end() { return &m_Value[0] + m_Value.size(); }
+    const char* begin() const { return m_Value.data(); }
+    const char* end() const { return m_Value.data() + m_Value.size(); }
+    bool reserve(unsigned int size) {
+        m_Value.reserve(size);
+        return true;
+    }
+    bool isEmpty() const { return m_Value.empty(); }
+    void clear() { m_Value.clear(); }
+
+    char operator[](unsigned int index) const { return index < m_Value.size() ? m_Value[index] : 0; }
+    char& operator[](unsigned int index) { return m_Value[index]; }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+    void setCharAt(unsigned int index, char value) {
+        if (index < m_Value.size()) {
+            m_Value[index] = value;
+        }
+    }
+
+    bool concat(const String& value) {
+        m_Value += value.m_Value;
+        return true;
+    }
+    bool concat(const char* value, unsigned int length) {
+        m_Value.append(value, length);
+        return true;
+    }
+    template <class T>
+    bool concat(const T& value) {
+        return concat(String(value));
+    }
+    template <class T>
+    String& operator+=(const T& value) {
+        concat(value);
+        return *this;
+    }
+
+    bool operator==(const String& other) const { return m_Value == other.m_Value; }
+    bool operator!=(const String& other) const { return m_Value != other.m_Value; }
+    bool operator==(const char* other) const { return m_Value == (other ? other : ""); }
+    bool operator!=(const char* other) const { return !(*this == other); }
+    bool operator<(const String& other) const { return m_Value < other.m_Value; }
+    bool operator>(const String& other) const { return m_Value > other.m_Value; }
+    bool operator<=(const String& other) const { return m_Value <= other.m_Value; }
+    bool operator>=(const String& other) const { return m_Value >= other.m_Value; }
+    bool equals(const String& other) const { return m_Value == other.m_Value; }
+    bool equalsIgnoreCase(const String& other) const {
+        return m_Value.size() == other.m_Value.size()
+               && std::equal(m_Value.begin(), m_Value.end(), other.m_Value.begin(), [](char a, char b) {
+                      return tolower((unsigned char)a) == tolower((unsigned char)b);
+                  });
+    }
+    int compareTo(const String& other) const { return m_Value.compare(other.m_Value); }
+    bool startsWith(const String& prefix) const { return m_Value.compare(0, prefix.length(), prefix.m_Value) == 0; }
+    bool startsWith(const String& prefix, unsigned int offset) const {
+        return offset <= m_Value.size() && m_Value.compare(offset, prefix.length(), prefix.m_Value) == 0;
+    }
+    bool endsWith(const String& suffix) const {
+        return m_Value.size() >= suffix.length()
+               && m_Value.compare(m_Value.size() - suffix.length(), suffix.length(), suffix.m_Value) == 0;
+    }
+
+    int indexOf(char value, unsigned int from = 0) const { return _index(m_Value.find(value, from)); }
+    int indexOf(const String& value, unsigned int from = 0) const { return _index(m_Value.find(value.m_Value, from)); }
+    int lastIndexOf(char value) const { return _index(m_Value.rfind(value)); }
+    int lastIndexOf(const String& value) const { return _index(m_Value.rfind(value.m_Value)); }
+    String substring(unsigned int from) const { return from > m_Value.size() ? String() : String(m_Value.substr(from)); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) {
+            std::swap(from, to);
+        }
+        return from > m_Value.size() ? String() : String(m_Value.substr(from, to - from));
+    }
+
+    void replace(char from, char to) { std::replace(m_Value.begin(), m_Value.end(), from, to); }
+    void replace(const String& from, const String& to) {
+        if (from.isEmpty()) {
+            return;
+        }
+        size_t index = 0;
+        while ((index = m_Value.find(from.m_Value, index)) != std::string::npos) {
+            m_Value.replace(index, from.length(), to.m_Value);
+            index += to.length();
+        }
+    }
+    void remove(unsigned int index) {
+        if (index < m_Value.size()) {
+            m_Value.erase(index);
+        }
+    }
+    void remove(unsigned int index, unsigned int count) {
+        if (index < m_Value.size()) {
+            m_Value.erase(index, count);
+        }
+    }
+    void toLowerCase() {
+        for (char& c : m_Value) {
+            c = tolower((unsigned char)c);
+        }
+    }
+    void toUpperCase() {
+        for (char& c : m_Value) {
+            c = toupper((unsigned char)c);
+        }
+    }
+    void trim() {
+        size_t first = m_Value.find_first_not_of(" \t\r\n\f\v");
+        size_t last  = m_Value.find_last_not_of(" \t\r\n\f\v");
+        m_Value      = first == std::string::npos ? std::string() : m_Value.substr(first, last - first + 1);
+    }
+
+    long toInt() const { return atol(m_Value.c_str()); }
+    float toFloat() const { return atof(m_Value.c_str()); }
+    double toDouble() const { return atof(m_Value.c_str()); }
+    void getBytes(unsigned char* buffer, unsigned int size, unsigned int index = 0) const {
+        toCharArray((char*)buffer, size, index);
+    }
+    void toCharArray(char* buffer, unsigned int size, unsigned int index = 0) const {
+        if (size == 0) {
+            return;
+        }
+        size_t count = index < m_Value.size() ? std::min<size_t>(size - 1, m_Value.size() - index) : 0;
+        memcpy(buffer, m_Value.data() + index, count);
+        buffer[count] = 0;
+    }
+
+    explicit operator bool() const { return true; }
+
+   private:
+    std::string m_Value;
+
+    template <class T>
+    static std::string _format(T value, unsigned char base) {
+        if (base == 10) {
+            return std::to_string(value);
+        }
+
+        bool isNegative = std::is_signed<T>::value && value < 0;
+        unsigned long long number = isNegative ? -(long long)value : (unsigned long long)value;
+        std::string result;
+        do {
+            result.insert(result.begin(), "0123456789abcdefghijklmnopqrstuvwxyz"[number % base]);
+            number /= base;
+        } while (number > 0);
+        return isNegative ? "-" + result : result;
+    }
+
+    static int _index(const size_t& index) {
+        return index == std::string::npos ? -1 : (int)index;
+    }
+};
+
+inline String operator+(const String& a, const String& b) {
+    String result = a;
+    result += b;
+    return result;
+}
+
+inline String operator+(const String& a, const char* b) {
+    return a + String(b);
+}
+
+inline String operator+(const char* a, const String& b) {
+    return String(a) + b;
+}
+
+template <class T, class = typename std::enable_if<std::is_arithmetic<T>::value>::type>
+String operator+(const String& a, const T& b) {
+    return a + String(b);
+}
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+/**
+ * This file stands in for the WiFi driver of the ESP32 on the host.
+ * The host is only connected once a test says so, and then its TCP clients
+ * reach the servers of the same program through in-memory pipes.
+ */
+
+#include <memory>
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+namespace Host {
+struct Socket;
+};
+
+/**
+ * @brief One end of a TCP connection. Copies share the connection, like on the ESP32.
+ *
+ */
+class WiFiClient {
+   public:
+    int connect(const char* host, uint16_t port);
+    size_t write(const uint8_t* buffer, size_t size);
+    int read(uint8_t* buffer, size_t size);
+    int available();
+    uint8_t connected();
+    IPAddress remoteIP();
+    uint16_t remotePort();
+    void stop();
+    int setNoDelay(bool isEnabled) { return 0; }
+    operator bool() { return connected(); }
+
+   private:
+    std::shared_ptr<Host::Socket> m_Socket;
+
+    friend class WiFiServer;
+};
+
+/**
+ * @brief A TCP server listening on a port of the host.
+ *
+ */
+class WiFiServer {
+   public:
+    WiFiServer(uint16_t port, uint8_t maxClients = 4)
+        : m_Port(port) {}
+
+    void begin();
+    WiFiClient available();
+    WiFiClient accept() { return available(); }
+    void stop();
+    void setNoDelay(bool isEnabled) {}
+
+   private:
+    uint16_t m_Port;
+};
+
+typedef enum {
+    WIFI_OFF,
+    WIFI_STA,
+    WIFI_AP,
+    WIFI_AP_STA
+} wifi_mode_t;
+
+typedef enum {
+    SYSTEM_EVENT_STA_CONNECTED,
+    SYSTEM_EVENT_STA_DISCONNECTED,
+    SYSTEM_EVENT_STA_GOT_IP,
+    SYSTEM_EVENT_AP_STACONNECTED,
+    SYSTEM_EVENT_AP_STADISCONNECTED,
+    SYSTEM_EVENT_AP_STAIPASSIGNED
+} WiFiEvent_t;
+
+typedef struct {
+    struct {
+        struct {
+            uint32_t addr;
+        } ip;
+    } wifi_ap_staipassigned;
+} WiFiEventInfo_t;
+
+typedef void (*WiFiEventFuncCb)(WiFiEvent_t event, WiFiEventInfo_t info);
+
+/**
+ * @brief The WiFi driver. The host has no radio, so the access point and the station
+ * only keep their settings, and the station is connected once a test says so.
+ *
+ */
+class WiFiClass {
+   public:
+    bool isConnected();
+    bool mode(wifi_mode_t mode) { return true; }
+    bool setHostname(const char* hostname) { return true; }
+    bool softAPsetHostname(const char* hostname) { return true; }
+    int onEvent(WiFiEventFuncCb handler) { return 0; }
+
+    bool softAP(const char* ssid, const char* password = NULL, int channel = 1, int isHidden = 0, int maxClients = 4) {
+        return true;
+    }
+    bool softAPdisconnect(bool isOff = false) { return true; }
+    String softAPmacAddress() { return "02:00:00:00:00:01"; }
+
+    int begin(const char* ssid, const char* password = NULL) {
+        m_SSID = ssid;
+        return 0;
+    }
+    bool disconnect(bool isOff = false) {
+        m_SSID = "";
+        return true;
+    }
+    String SSID() { return m_SSID; }
+    IPAddress localIP() { return isConnected() ? IPAddress(127, 0, 0, 1) : IPAddress(); }
+    String macAddress() { return "02:00:00:00:00:02"; }
+
+   private:
+    String m_SSID;
+};
+
+extern WiFiClass WiFi;
+
+#endif
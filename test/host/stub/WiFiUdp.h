@@ -0,0 +1,27 @@
+#ifndef HOST_WIFI_UDP_H
+#define HOST_WIFI_UDP_H
+
+/**
+ * This file stands in for the UDP sockets of the ESP32 on the host.
+ * Nothing is sent and nothing is received.
+ */
+
+#include "Arduino.h"
+
+class WiFiUDP : public Stream {
+   public:
+    uint8_t begin(uint16_t port) { return 1; }
+    void stop() {}
+    int beginPacket(const char* host, uint16_t port) { return 0; }
+    int beginPacket(IPAddress ip, uint16_t port) { return 0; }
+    int endPacket() { return 0; }
+    int parsePacket() { return 0; }
+    size_t write(uint8_t value) override { return 0; }
+    size_t write(const uint8_t* buffer, size_t size) override { return 0; }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int read(uint8_t* buffer, size_t size) { return 0; }
+    int peek() override { return -1; }
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+/**
+ * This file stands in for the I2C driver of the ESP32 on the host. Tests attach
+ * models of the devices to the bus. Like the driver, a transmission holds the bus
+ * from beginTransmission() to endTransmission(), and setClock() and requestFrom()
+ * hold it while they run. Host.cpp implements the bus.
+ */
+
+#include "Arduino.h"
+
+#include <map>
+#include <mutex>
+
+#define I2C_BUFFER_LENGTH 128
+
+/**
+ * @brief A model of a device on the bus.
+ *
+ */
+class I2CDevice {
+   public:
+    virtual ~I2CDevice() {}
+
+    /**
+     * @brief Take the bytes of a transmission to the device.
+     *
+     * @param data is the bytes.
+     * @param size is the number of bytes.
+     * @param clock is the clock of the bus in Hz.
+     */
+    virtual void receive(const uint8_t* data, const size_t& size, const uint32_t& clock) = 0;
+
+    /**
+     * @brief Give the bytes of a request to the device.
+     *
+     * @param data is the buffer to fill.
+     * @param size is the number of bytes requested.
+     * @param clock is the clock of the bus in Hz.
+     * @return the number of bytes given.
+     */
+    virtual size_t transmit(uint8_t* data, const size_t& size, const uint32_t& clock) { return 0; }
+};
+
+class TwoWire : public Stream {
+   public:
+    TwoWire(uint8_t bus = 0);
+
+    void attach(const uint8_t& address, I2CDevice* device);
+    void detach(const uint8_t& address);
+
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+    bool setClock(uint32_t frequency);
+    uint32_t getClock();
+    void beginTransmission(uint16_t address);
+    uint8_t endTransmission(bool sendStop = true);
+    size_t requestFrom(uint16_t address, size_t size, bool sendStop = true);
+    size_t requestFrom(uint8_t address, uint8_t size, uint8_t sendStop = true) {
+        return requestFrom((uint16_t)address, (size_t)size, (bool)sendStop);
+    }
+    size_t requestFrom(int address, int size, int sendStop = true) {
+        return requestFrom((uint16_t)address, (size_t)size, (bool)sendStop);
+    }
+    size_t setBufferSize(size_t size) { return I2C_BUFFER_LENGTH; }
+
+    size_t write(uint8_t value) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    int available() override;
+    int read() override;
+    int peek() override;
+
+   private:
+    std::recursive_mutex m_Lock;
+    std::map<uint8_t, I2CDevice*> m_Devices;
+    uint32_t m_Clock;
+    uint16_t m_Address;
+    uint8_t m_Transmission[I2C_BUFFER_LENGTH];
+    size_t m_TransmissionSize;
+    uint8_t m_Received[I2C_BUFFER_LENGTH];
+    size_t m_ReceivedSize;
+    size_t m_ReadIndex;
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef HOST_ESP_WIFI_H
+#define HOST_ESP_WIFI_H
+
+/**
+ * This file stands in for the WiFi driver API of the ESP-IDF on the host.
+ */
+
+#include "Arduino.h"
+
+typedef int esp_err_t;
+
+typedef enum {
+    WIFI_IF_STA = 0,
+    WIFI_IF_AP  = 1,
+} wifi_interface_t;
+
+#define ESP_OK 0
+
+inline esp_err_t esp_wifi_set_mac(wifi_interface_t interface, const uint8_t* mac) { return ESP_OK; }
+
+#endif
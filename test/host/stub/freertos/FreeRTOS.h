@@ -0,0 +1,60 @@
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+/**
+ * This file stands in for FreeRTOS on the host. Tasks are threads, and the
+ * semaphores and notifications block for real. Host.cpp implements them.
+ */
+
+#include <stdint.h>
+
+typedef void* TaskHandle_t;
+typedef void* SemaphoreHandle_t;
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef void (*TaskFunction_t)(void*);
+
+#define portMAX_DELAY 0xFFFFFFFF
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) (ms)
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define tskIDLE_PRIORITY 0
+#define configMAX_PRIORITIES 25
+#define portYIELD_FROM_ISR(...) ((void)0)
+
+BaseType_t xTaskCreate(
+    TaskFunction_t function, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority,
+    TaskHandle_t* task
+);
+BaseType_t xTaskCreatePinnedToCore(
+    TaskFunction_t function, const char* name, uint32_t stackSize, void* parameter, UBaseType_t priority,
+    TaskHandle_t* task, BaseType_t core
+);
+void vTaskDelete(TaskHandle_t task);
+void vTaskDelay(TickType_t ticks);
+void taskYIELD();
+TickType_t xTaskGetTickCount();
+TaskHandle_t xTaskGetCurrentTaskHandle();
+uint8_t* pxTaskGetStackStart(TaskHandle_t task);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* isWoken);
+uint32_t ulTaskNotifyTake(BaseType_t isCleared, TickType_t ticks);
+
+SemaphoreHandle_t xSemaphoreCreateBinary();
+SemaphoreHandle_t xSemaphoreCreateMutex();
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex();
+void vSemaphoreDelete(SemaphoreHandle_t semaphore);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t semaphore, TickType_t ticks);
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t semaphore);
+UBaseType_t uxSemaphoreGetCount(SemaphoreHandle_t semaphore);
+
+#define xSemaphoreGetCount(semaphore) uxSemaphoreGetCount(semaphore)
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef HOST_LWIP_DEF_H
+#define HOST_LWIP_DEF_H
+
+/**
+ * This file stands in for lwIP on the host. The byte order functions are in Arduino.h.
+ */
+
+#include "Arduino.h"
+
+#endif
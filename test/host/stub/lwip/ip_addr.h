@@ -0,0 +1,8 @@
+#ifndef HOST_LWIP_IP_ADDR_H
+#define HOST_LWIP_IP_ADDR_H
+
+/**
+ * This file stands in for lwIP on the host. The sources only include it.
+ */
+
+#endif
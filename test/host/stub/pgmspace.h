@@ -0,0 +1,11 @@
+#ifndef HOST_PGMSPACE_H
+#define HOST_PGMSPACE_H
+
+/**
+ * The flash of the ESP32 is mapped into its address space, and so is the
+ * memory of the host, so Arduino.h reads PROGMEM data as plain memory.
+ */
+
+#include "Arduino.h"
+
+#endif